@@ -1,3 +1,4 @@
 ~/dev/ctime/ctime -begin delone_timings.ctm
 g++ -g -std=c++11 sdl_delone.cpp -l SDL2 -l SDL2_ttf -o ../build/delone.sh
+g++ -g -std=c++11 -DDELONE_SLOW=1 sdl_delone.cpp -l SDL2 -l SDL2_ttf -o ../build/delone_debug.sh
 ~/dev/ctime/ctime -end delone_timings.ctm
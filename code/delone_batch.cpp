@@ -0,0 +1,368 @@
+/* ------------------------------
+ *      batch triangulation
+ * ------------------------------ */
+
+/*
+ * NOTE(hugo) : TriangulateBatch runs many small independent triangulations (one per tile or per
+ * object for instance) on the work queue threads.
+ *   - the sets are handed out one at a time through an atomic counter, so small and large sets mix well
+ *   - every thread owns a batch_worker : its memory is sized from the largest set of the batch and only
+ *     reallocated when a later batch has a larger set. The workers belong to the caller and can be kept
+ *     from one batch to the next.
+ *   - points are inserted with InsertVertex, so a set costs about its own size, not its size squared
+ *   - the super triangle is the symbolic one at infinity : it holds any set of the kernel range, and the
+ *     triangles without a fake vertex are directly the Delaunay triangulation of the set, hull included,
+ *     with no finalize pass
+ *   - the triangles of all the sets end up one after the other in a single buffer, in set order,
+ *     whatever the number of threads
+ *   - a set that cannot be triangulated (coordinates out of the kernel range, or no memory for its size)
+ *     is rejected on its own with no triangles, the rest of the batch goes on
+ */
+
+enum batch_set_status
+{
+	BatchSet_Triangulated,
+	// NOTE(hugo) : The worker memory for a set of this size could not be allocated
+	BatchSet_TooManyPoints,
+	BatchSet_OutOfRange,
+};
+
+struct batch_set
+{
+	// NOTE(hugo) : Input : PointCount points starting at point FirstPointIndex of the batch
+	int FirstPointIndex;
+	int PointCount;
+
+	// NOTE(hugo) : Output : TriangleCount triangles starting at triangle FirstTriangleIndex of the batch.
+	// Vertex indices are relative to FirstPointIndex, duplicated points only appear once.
+	int FirstTriangleIndex;
+	int TriangleCount;
+	int DuplicatePointCount;
+	batch_set_status Status;
+};
+
+template<typename kernel>
+struct triangulation_batch
+{
+	// NOTE(hugo) : x0, y0, x1, y1, ...
+	typename kernel::coord* Positions;
+	batch_set* Sets;
+	int SetCount;
+
+	// NOTE(hugo) : Counter clockwise, 3 per triangle, room for GetBatchTriangleCapacity triangles
+	int* TriangleVertexIndices;
+	// NOTE(hugo) : The triangles of a set come in the order the triangulation left them in, unless this is
+	// set : they are then sorted along the Hilbert curve of the set, like FinalizeTriangulation does. The
+	// vertices keep the numbering of the input either way.
+	bool SortTrianglesAlongCurve;
+};
+
+template<typename kernel>
+struct batch_worker
+{
+	// NOTE(hugo) : Zeroed by the caller before the first batch and released with FreeBatchWorkers.
+	// Everything below points in Memory and has room for MaxPointCount points.
+	void* Memory;
+	int MaxPointCount;
+
+	triangulation<kernel> Triangulation;
+	// NOTE(hugo) : Index in the set of each vertex of the triangulation
+	int* SetPointIndices;
+	// NOTE(hugo) : The points along the Hilbert curve, then the triangles when they are sorted too
+	sort_entry* SortEntries;
+	sort_entry* SortTemp;
+
+	// NOTE(hugo) : For the last batch only
+	int TriangulationCount;
+	uint64_t BusyCounter;
+};
+
+template<typename kernel>
+struct batch_job
+{
+	triangulation_batch<kernel>* Batch;
+	batch_worker<kernel>* Workers;
+	// NOTE(hugo) : Room every worker has, the same for all of them so the result does not depend on which one gets a set
+	int MaxPointCount;
+	SDL_atomic_t NextSetIndex;
+};
+
+int GetBatchTriangleCapacity(batch_set* Sets, int SetCount)
+{
+	// NOTE(hugo) : n points give at most 2n - 5 triangles. While the threads run, every set writes
+	// in a slot of 2n triangles, the slots are packed afterwards.
+	int Result = 0;
+	for(int SetIndex = 0; SetIndex < SetCount; ++SetIndex)
+	{
+		Result += 2 * Sets[SetIndex].PointCount;
+	}
+
+	return(Result);
+}
+
+template<typename kernel>
+size_t GetBatchWorkerMemorySize(int MaxPointCount)
+{
+	// NOTE(hugo) : The three fake vertices come on top of the points, and a set has less than 2n triangles to sort
+	size_t Result = 0;
+	Result += GetTriangulationMemorySize<kernel>(MaxPointCount + 3);
+	Result += (MaxPointCount + 3) * sizeof(int);
+	Result += 2 * 2 * MaxPointCount * sizeof(sort_entry);
+	// NOTE(hugo) : Alignment padding
+	Result += 16 * 3;
+
+	return(Result);
+}
+
+template<typename kernel>
+bool ReserveBatchWorker(batch_worker<kernel>* Worker, int MaxPointCount)
+{
+	// NOTE(hugo) : False if the memory could not be allocated, the worker then has no room at all
+	if(Worker->Memory && (Worker->MaxPointCount >= MaxPointCount))
+	{
+		return(true);
+	}
+
+	free(Worker->Memory);
+	size_t MemorySize = GetBatchWorkerMemorySize<kernel>(MaxPointCount);
+	Worker->Memory = malloc(MemorySize);
+	Worker->MaxPointCount = 0;
+	if(!Worker->Memory)
+	{
+		return(false);
+	}
+
+	memory_arena Arena = {};
+	Arena.Base = (uint8_t*)Worker->Memory;
+	Arena.Size = MemorySize;
+	PushTriangulation(&Arena, &Worker->Triangulation, MaxPointCount + 3);
+	Worker->SetPointIndices = PushArray(&Arena, MaxPointCount + 3, int);
+	Worker->SortEntries = PushArray(&Arena, 2 * MaxPointCount, sort_entry);
+	Worker->SortTemp = PushArray(&Arena, 2 * MaxPointCount, sort_entry);
+	Worker->MaxPointCount = MaxPointCount;
+
+	return(true);
+}
+
+template<typename kernel>
+void FreeBatchWorkers(batch_worker<kernel>* Workers, int WorkerCount)
+{
+	for(int WorkerIndex = 0; WorkerIndex < WorkerCount; ++WorkerIndex)
+	{
+		free(Workers[WorkerIndex].Memory);
+		Workers[WorkerIndex] = {};
+	}
+}
+
+template<typename kernel>
+void TriangulateSet(batch_worker<kernel>* Worker, triangulation_batch<kernel>* Batch, batch_set* Set, int MaxPointCount)
+{
+	typedef typename kernel::coord coord;
+	typedef typename kernel::real real;
+
+	Set->TriangleCount = 0;
+	Set->DuplicatePointCount = 0;
+	Set->Status = BatchSet_Triangulated;
+	if(Set->PointCount > MaxPointCount)
+	{
+		Set->Status = BatchSet_TooManyPoints;
+		return;
+	}
+	if(Set->PointCount == 0)
+	{
+		return;
+	}
+
+	coord* Positions = Batch->Positions + 2 * Set->FirstPointIndex;
+	for(int i = 0; i < 2 * Set->PointCount; ++i)
+	{
+		if(!kernel::IsInRange(Positions[i]))
+		{
+			Set->Status = BatchSet_OutOfRange;
+			return;
+		}
+	}
+
+	coord MinX = Positions[0];
+	coord MinY = Positions[1];
+	coord MaxX = Positions[0];
+	coord MaxY = Positions[1];
+	for(int PointIndex = 1; PointIndex < Set->PointCount; ++PointIndex)
+	{
+		coord x = Positions[2 * PointIndex + 0];
+		coord y = Positions[2 * PointIndex + 1];
+		MinX = (x < MinX) ? x : MinX;
+		MinY = (y < MinY) ? y : MinY;
+		MaxX = (x > MaxX) ? x : MaxX;
+		MaxY = (y > MaxY) ? y : MaxY;
+	}
+
+	// NOTE(hugo) : Inserting along a Hilbert curve keeps every walk from the previous point short.
+	// The extent is computed in real, it does not fit in coord for a set spanning the whole range.
+	real Extent = ((real(MaxX) - real(MinX)) > (real(MaxY) - real(MinY))) ? (real(MaxX) - real(MinX)) : (real(MaxY) - real(MinY));
+	hilbert_frame<kernel> Frame = {};
+	Frame.MinX = real(MinX);
+	Frame.MinY = real(MinY);
+	Frame.Scale = (Extent > 0) ? (real(65535) / Extent) : real(0);
+	for(int PointIndex = 0; PointIndex < Set->PointCount; ++PointIndex)
+	{
+		Worker->SortEntries[PointIndex].SortKey = HilbertIndex(Frame, real(Positions[2 * PointIndex + 0]), real(Positions[2 * PointIndex + 1]));
+		Worker->SortEntries[PointIndex].Index = PointIndex;
+	}
+	MergeSort(Set->PointCount, Worker->SortEntries, Worker->SortTemp);
+
+	triangulation<kernel>* T = &Worker->Triangulation;
+	InitTriangulationAtInfinity(T);
+	for(int OrderIndex = 0; OrderIndex < Set->PointCount; ++OrderIndex)
+	{
+		int PointIndex = Worker->SortEntries[OrderIndex].Index;
+		vertex<kernel> V = {Positions[2 * PointIndex + 0], Positions[2 * PointIndex + 1], true};
+		int VertexIndex = InsertVertex(T, V);
+		if(VertexIndex == -1)
+		{
+			Set->DuplicatePointCount++;
+		}
+		else
+		{
+			Worker->SetPointIndices[VertexIndex] = PointIndex;
+		}
+	}
+
+	// NOTE(hugo) : The fake vertices are 0, 1 and 2, every triangle without them is kept. There are none
+	// when the points are all aligned.
+	int* Out = Batch->TriangleVertexIndices + 3 * Set->FirstTriangleIndex;
+	int TriangleCount = 0;
+	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
+	{
+		triangle F = T->Triangles[TriangleIndex];
+		if((F.Vertex0Index < 3) || (F.Vertex1Index < 3) || (F.Vertex2Index < 3))
+		{
+			continue;
+		}
+
+		if(Batch->SortTrianglesAlongCurve)
+		{
+			vertex<kernel> A = T->Vertices[F.Vertex0Index];
+			vertex<kernel> B = T->Vertices[F.Vertex1Index];
+			vertex<kernel> C = T->Vertices[F.Vertex2Index];
+			real CentroidX = (real(A.x) + real(B.x) + real(C.x)) / real(3);
+			real CentroidY = (real(A.y) + real(B.y) + real(C.y)) / real(3);
+			Worker->SortEntries[TriangleCount].SortKey = HilbertIndex(Frame, CentroidX, CentroidY);
+			Worker->SortEntries[TriangleCount].Index = TriangleIndex;
+		}
+		else
+		{
+			int VertexIndices[3];
+			OrientedTriangleVertices(T, TriangleIndex, VertexIndices);
+			for(int i = 0; i < 3; ++i)
+			{
+				Out[3 * TriangleCount + i] = Worker->SetPointIndices[VertexIndices[i]];
+			}
+		}
+		TriangleCount++;
+	}
+	Assert(TriangleCount <= 2 * Set->PointCount);
+
+	if(Batch->SortTrianglesAlongCurve)
+	{
+		MergeSort(TriangleCount, Worker->SortEntries, Worker->SortTemp);
+		for(int NewIndex = 0; NewIndex < TriangleCount; ++NewIndex)
+		{
+			int VertexIndices[3];
+			OrientedTriangleVertices(T, Worker->SortEntries[NewIndex].Index, VertexIndices);
+			for(int i = 0; i < 3; ++i)
+			{
+				Out[3 * NewIndex + i] = Worker->SetPointIndices[VertexIndices[i]];
+			}
+		}
+	}
+	Set->TriangleCount = TriangleCount;
+}
+
+template<typename kernel>
+void DoBatchSets(int ThreadIndex, void* Data)
+{
+	batch_job<kernel>* Job = (batch_job<kernel>*)Data;
+	batch_worker<kernel>* Worker = Job->Workers + ThreadIndex;
+	for(;;)
+	{
+		int SetIndex = SDL_AtomicAdd(&Job->NextSetIndex, 1);
+		if(SetIndex >= Job->Batch->SetCount)
+		{
+			break;
+		}
+
+		uint64_t Start = SDL_GetPerformanceCounter();
+		TriangulateSet(Worker, Job->Batch, Job->Batch->Sets + SetIndex, Job->MaxPointCount);
+		Worker->BusyCounter += SDL_GetPerformanceCounter() - Start;
+		Worker->TriangulationCount++;
+	}
+}
+
+template<typename kernel>
+int TriangulateBatch(triangulation_batch<kernel>* Batch, batch_worker<kernel>* Workers, int ThreadCount)
+{
+	// NOTE(hugo) : Workers must hold ThreadCount entries, zeroed or kept from a previous batch. Returns the
+	// number of triangles written.
+	if(ThreadCount < 1)
+	{
+		ThreadCount = 1;
+	}
+	if(ThreadCount > MAX_THREAD_COUNT)
+	{
+		ThreadCount = MAX_THREAD_COUNT;
+	}
+	for(int ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		Workers[ThreadIndex].TriangulationCount = 0;
+		Workers[ThreadIndex].BusyCounter = 0;
+	}
+
+	int SlotStart = 0;
+	int LargestPointCount = 0;
+	for(int SetIndex = 0; SetIndex < Batch->SetCount; ++SetIndex)
+	{
+		Batch->Sets[SetIndex].FirstTriangleIndex = SlotStart;
+		SlotStart += 2 * Batch->Sets[SetIndex].PointCount;
+		LargestPointCount = (Batch->Sets[SetIndex].PointCount > LargestPointCount) ? Batch->Sets[SetIndex].PointCount : LargestPointCount;
+	}
+
+	// NOTE(hugo) : Allocated here, before the threads run. If some worker could not get the room for the
+	// largest set, the sets that do not fit in every worker are rejected.
+	int MaxPointCount = LargestPointCount;
+	for(int ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		ReserveBatchWorker(Workers + ThreadIndex, LargestPointCount);
+		MaxPointCount = (Workers[ThreadIndex].MaxPointCount < MaxPointCount) ? Workers[ThreadIndex].MaxPointCount : MaxPointCount;
+	}
+
+	batch_job<kernel> Job;
+	Job.Batch = Batch;
+	Job.Workers = Workers;
+	Job.MaxPointCount = MaxPointCount;
+	SDL_AtomicSet(&Job.NextSetIndex, 0);
+
+	// NOTE(hugo) : One entry per thread, the sets themselves are handed out by NextSetIndex
+	work_queue Queue = {};
+	for(int ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		AddWorkEntry(&Queue, DoBatchSets<kernel>, &Job);
+	}
+	CompleteAllWork(&Queue, ThreadCount);
+
+	// NOTE(hugo) : Packing the slots, a set never moves past its own slot so this can be done in place
+	int TriangleCount = 0;
+	for(int SetIndex = 0; SetIndex < Batch->SetCount; ++SetIndex)
+	{
+		batch_set* Set = Batch->Sets + SetIndex;
+		if(Set->FirstTriangleIndex != TriangleCount)
+		{
+			memmove(Batch->TriangleVertexIndices + 3 * TriangleCount, Batch->TriangleVertexIndices + 3 * Set->FirstTriangleIndex,
+					3 * Set->TriangleCount * sizeof(Batch->TriangleVertexIndices[0]));
+			Set->FirstTriangleIndex = TriangleCount;
+		}
+		TriangleCount += Set->TriangleCount;
+	}
+
+	return(TriangleCount);
+}
@@ -0,0 +1,871 @@
+#if !defined(DELONE_KERNEL_H)
+#define DELONE_KERNEL_H
+
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+
+#include "delone_platform.h"
+
+/*
+ * NOTE(hugo) : A kernel chooses at compile time the coordinate type of the triangulation
+ * and how the two predicates everything relies on are evaluated :
+ *   - Orient2D(A, B, C) : 1 if C is on the left of AB, -1 if it is on the right, 0 if ABC are aligned
+ *   - InCircle(A, B, C, D) : 1 if D is inside the circle of the counter clockwise triangle ABC,
+ *     -1 if it is outside, 0 if the four points are on the same circle
+ *   - Dot2D(A, B, C) : sign of CA.CB, -1 if C is strictly inside the circle of diameter AB
+ * They are always exact, each kernel just picks the cheapest arithmetic that makes them so.
+ * SquaredDistanceKey(A, B) orders distances, exactly for kernel_i32 and up to rounding for the others.
+ */
+
+typedef __int128 int128;
+
+inline int Sign(int64_t Value)
+{
+	return((Value > 0) - (Value < 0));
+}
+
+inline int Sign(int128 Value)
+{
+	return((Value > 0) - (Value < 0));
+}
+
+inline int Sign(double Value)
+{
+	return((Value > 0.0) - (Value < 0.0));
+}
+
+/* ------------------------------
+ *     exact expansion arithmetic
+ * ------------------------------ */
+
+// NOTE(hugo) : This is Shewchuk's arithmetic (Adaptive Precision Floating-Point Arithmetic and
+// Fast Robust Geometric Predicates). A number is represented exactly as the sum of the components
+// of an expansion, sorted by increasing magnitude and non-overlapping, so its sign is the sign
+// of its last component.
+
+static const double ExpansionEpsilon = 1.1102230246251565e-16; // NOTE(hugo) : 2^-53
+static const double ExpansionSplitter = 134217729.0; // NOTE(hugo) : 2^27 + 1
+static const double Orient2DErrorBound = (3.0 + 16.0 * ExpansionEpsilon) * ExpansionEpsilon;
+static const double InCircleErrorBound = (10.0 + 96.0 * ExpansionEpsilon) * ExpansionEpsilon;
+
+inline void TwoSum(double a, double b, double* x, double* y)
+{
+	*x = a + b;
+	double BVirtual = *x - a;
+	double AVirtual = *x - BVirtual;
+	double BRoundoff = b - BVirtual;
+	double ARoundoff = a - AVirtual;
+	*y = ARoundoff + BRoundoff;
+}
+
+inline void TwoDiff(double a, double b, double* x, double* y)
+{
+	*x = a - b;
+	double BVirtual = a - *x;
+	double AVirtual = *x + BVirtual;
+	double BRoundoff = BVirtual - b;
+	double ARoundoff = a - AVirtual;
+	*y = ARoundoff + BRoundoff;
+}
+
+inline void Split(double a, double* High, double* Low)
+{
+	double c = ExpansionSplitter * a;
+	double ABig = c - a;
+	*High = c - ABig;
+	*Low = a - *High;
+}
+
+inline void TwoProduct(double a, double b, double* x, double* y)
+{
+	*x = a * b;
+	double AHigh, ALow, BHigh, BLow;
+	Split(a, &AHigh, &ALow);
+	Split(b, &BHigh, &BLow);
+	double Error1 = *x - (AHigh * BHigh);
+	double Error2 = Error1 - (ALow * BHigh);
+	double Error3 = Error2 - (AHigh * BLow);
+	*y = (ALow * BLow) - Error3;
+}
+
+int ExpansionSum(int ELength, double* E, int FLength, double* F, double* H)
+{
+	// NOTE(hugo) : fast_expansion_sum_zeroelim, H must hold ELength + FLength components
+	if((ELength == 0) || (FLength == 0))
+	{
+		double* Source = (ELength == 0) ? F : E;
+		int SourceLength = (ELength == 0) ? FLength : ELength;
+		for(int i = 0; i < SourceLength; ++i)
+		{
+			H[i] = Source[i];
+		}
+		return(SourceLength);
+	}
+
+	double Q, QNew, HH;
+	double ENow = E[0];
+	double FNow = F[0];
+	int EIndex = 0;
+	int FIndex = 0;
+	int HIndex = 0;
+	if((FNow > ENow) == (FNow > -ENow))
+	{
+		Q = ENow;
+		++EIndex;
+		if(EIndex < ELength)
+		{
+			ENow = E[EIndex];
+		}
+	}
+	else
+	{
+		Q = FNow;
+		++FIndex;
+		if(FIndex < FLength)
+		{
+			FNow = F[FIndex];
+		}
+	}
+
+	if((EIndex < ELength) && (FIndex < FLength))
+	{
+		if((FNow > ENow) == (FNow > -ENow))
+		{
+			QNew = ENow + Q;
+			HH = Q - (QNew - ENow);
+			++EIndex;
+			if(EIndex < ELength)
+			{
+				ENow = E[EIndex];
+			}
+		}
+		else
+		{
+			QNew = FNow + Q;
+			HH = Q - (QNew - FNow);
+			++FIndex;
+			if(FIndex < FLength)
+			{
+				FNow = F[FIndex];
+			}
+		}
+		Q = QNew;
+		if(HH != 0.0)
+		{
+			H[HIndex++] = HH;
+		}
+
+		while((EIndex < ELength) && (FIndex < FLength))
+		{
+			if((FNow > ENow) == (FNow > -ENow))
+			{
+				TwoSum(Q, ENow, &QNew, &HH);
+				++EIndex;
+				if(EIndex < ELength)
+				{
+					ENow = E[EIndex];
+				}
+			}
+			else
+			{
+				TwoSum(Q, FNow, &QNew, &HH);
+				++FIndex;
+				if(FIndex < FLength)
+				{
+					FNow = F[FIndex];
+				}
+			}
+			Q = QNew;
+			if(HH != 0.0)
+			{
+				H[HIndex++] = HH;
+			}
+		}
+	}
+
+	while(EIndex < ELength)
+	{
+		TwoSum(Q, ENow, &QNew, &HH);
+		++EIndex;
+		if(EIndex < ELength)
+		{
+			ENow = E[EIndex];
+		}
+		Q = QNew;
+		if(HH != 0.0)
+		{
+			H[HIndex++] = HH;
+		}
+	}
+	while(FIndex < FLength)
+	{
+		TwoSum(Q, FNow, &QNew, &HH);
+		++FIndex;
+		if(FIndex < FLength)
+		{
+			FNow = F[FIndex];
+		}
+		Q = QNew;
+		if(HH != 0.0)
+		{
+			H[HIndex++] = HH;
+		}
+	}
+
+	if((Q != 0.0) || (HIndex == 0))
+	{
+		H[HIndex++] = Q;
+	}
+	return(HIndex);
+}
+
+int ScaleExpansion(int ELength, double* E, double b, double* H)
+{
+	// NOTE(hugo) : scale_expansion_zeroelim, H must hold 2 * ELength components
+	double Q, Sum, HH, Product1, Product0;
+	int HIndex = 0;
+	TwoProduct(E[0], b, &Q, &HH);
+	if(HH != 0.0)
+	{
+		H[HIndex++] = HH;
+	}
+	for(int EIndex = 1; EIndex < ELength; ++EIndex)
+	{
+		TwoProduct(E[EIndex], b, &Product1, &Product0);
+		TwoSum(Q, Product0, &Sum, &HH);
+		if(HH != 0.0)
+		{
+			H[HIndex++] = HH;
+		}
+		// NOTE(hugo) : This is Fast-Two-Sum, Product1 is always bigger than Sum
+		Q = Product1 + Sum;
+		HH = Sum - (Q - Product1);
+		if(HH != 0.0)
+		{
+			H[HIndex++] = HH;
+		}
+	}
+	if((Q != 0.0) || (HIndex == 0))
+	{
+		H[HIndex++] = Q;
+	}
+	return(HIndex);
+}
+
+// NOTE(hugo) : The longest product any predicate takes is lift(16) * cross(16) in ExactInCircle
+#define MAX_EXPANSION_PRODUCT_LENGTH (2 * 16 * 16)
+
+int ExpansionProduct(int ELength, double* E, int FLength, double* F, double* H)
+{
+	// NOTE(hugo) : H must hold 2 * ELength * FLength components. The partial sums go back and forth
+	// between H and Temp, starting on the side that makes the last one land in H.
+	double Scaled[2 * 16];
+	double Temp[MAX_EXPANSION_PRODUCT_LENGTH];
+	Assert(2 * ELength <= ArrayCount(Scaled));
+	Assert(2 * ELength * FLength <= ArrayCount(Temp));
+	double* Accumulators[2] = {H, Temp};
+	int AccumulatorLength = 0;
+	int Current = FLength & 1;
+	for(int FIndex = 0; FIndex < FLength; ++FIndex)
+	{
+		int ScaledLength = ScaleExpansion(ELength, E, F[FIndex], Scaled);
+		AccumulatorLength = ExpansionSum(AccumulatorLength, Accumulators[Current], ScaledLength, Scaled, Accumulators[1 - Current]);
+		Current = 1 - Current;
+	}
+	return(AccumulatorLength);
+}
+
+inline void NegateExpansion(int ELength, double* E)
+{
+	for(int i = 0; i < ELength; ++i)
+	{
+		E[i] = -E[i];
+	}
+}
+
+int ExactOrient2D(double ax, double ay, double bx, double by, double cx, double cy)
+{
+	// NOTE(hugo) : (ax - cx) * (by - cy) - (ay - cy) * (bx - cx) with every difference kept exact
+	double ACX[2], ACY[2], BCX[2], BCY[2];
+	TwoDiff(ax, cx, &ACX[1], &ACX[0]);
+	TwoDiff(ay, cy, &ACY[1], &ACY[0]);
+	TwoDiff(bx, cx, &BCX[1], &BCX[0]);
+	TwoDiff(by, cy, &BCY[1], &BCY[0]);
+
+	double Left[8];
+	double Right[8];
+	double Determinant[16];
+	int LeftLength = ExpansionProduct(2, ACX, 2, BCY, Left);
+	int RightLength = ExpansionProduct(2, ACY, 2, BCX, Right);
+	NegateExpansion(RightLength, Right);
+	int DeterminantLength = ExpansionSum(LeftLength, Left, RightLength, Right, Determinant);
+
+	return(Sign(Determinant[DeterminantLength - 1]));
+}
+
+int ExactDot2D(double ax, double ay, double bx, double by, double cx, double cy)
+{
+	// NOTE(hugo) : (ax - cx) * (bx - cx) + (ay - cy) * (by - cy) with every difference kept exact
+	double ACX[2], ACY[2], BCX[2], BCY[2];
+	TwoDiff(ax, cx, &ACX[1], &ACX[0]);
+	TwoDiff(ay, cy, &ACY[1], &ACY[0]);
+	TwoDiff(bx, cx, &BCX[1], &BCX[0]);
+	TwoDiff(by, cy, &BCY[1], &BCY[0]);
+
+	double XProduct[8];
+	double YProduct[8];
+	double Dot[16];
+	int XProductLength = ExpansionProduct(2, ACX, 2, BCX, XProduct);
+	int YProductLength = ExpansionProduct(2, ACY, 2, BCY, YProduct);
+	int DotLength = ExpansionSum(XProductLength, XProduct, YProductLength, YProduct, Dot);
+
+	return(Sign(Dot[DotLength - 1]));
+}
+
+int ExactSumOfDifferences(double a, double b, double c, double d)
+{
+	// NOTE(hugo) : Sign of (a - b) + (c - d) with both differences kept exact
+	double AB[2], CD[2];
+	TwoDiff(a, b, &AB[1], &AB[0]);
+	TwoDiff(c, d, &CD[1], &CD[0]);
+
+	double Sum[4];
+	int SumLength = ExpansionSum(2, AB, 2, CD, Sum);
+
+	return(Sign(Sum[SumLength - 1]));
+}
+
+int ExactInCircle(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+	double Diffs[6][2];
+	TwoDiff(ax, dx, &Diffs[0][1], &Diffs[0][0]);
+	TwoDiff(ay, dy, &Diffs[1][1], &Diffs[1][0]);
+	TwoDiff(bx, dx, &Diffs[2][1], &Diffs[2][0]);
+	TwoDiff(by, dy, &Diffs[3][1], &Diffs[3][0]);
+	TwoDiff(cx, dx, &Diffs[4][1], &Diffs[4][0]);
+	TwoDiff(cy, dy, &Diffs[5][1], &Diffs[5][0]);
+
+	// NOTE(hugo) : det = lift(a) * cross(b, c) + lift(b) * cross(c, a) + lift(c) * cross(a, b).
+	// Each term has at most 2 * 16 * 16 components, so the sum 3 times that : about 30 KB of stack in all.
+	double Sum[2][3 * MAX_EXPANSION_PRODUCT_LENGTH];
+	int SumLength = 0;
+	int Current = 0;
+	for(int i = 0; i < 3; ++i)
+	{
+		double* UX = Diffs[2 * i];
+		double* UY = Diffs[2 * i + 1];
+		double* VX = Diffs[(2 * i + 2) % 6];
+		double* VY = Diffs[(2 * i + 3) % 6];
+		double* WX = Diffs[(2 * i + 4) % 6];
+		double* WY = Diffs[(2 * i + 5) % 6];
+
+		double X2[8], Y2[8], Lift[16];
+		int X2Length = ExpansionProduct(2, UX, 2, UX, X2);
+		int Y2Length = ExpansionProduct(2, UY, 2, UY, Y2);
+		int LiftLength = ExpansionSum(X2Length, X2, Y2Length, Y2, Lift);
+
+		double VXWY[8], WXVY[8], Cross[16];
+		int VXWYLength = ExpansionProduct(2, VX, 2, WY, VXWY);
+		int WXVYLength = ExpansionProduct(2, WX, 2, VY, WXVY);
+		NegateExpansion(WXVYLength, WXVY);
+		int CrossLength = ExpansionSum(VXWYLength, VXWY, WXVYLength, WXVY, Cross);
+
+		double Term[MAX_EXPANSION_PRODUCT_LENGTH];
+		int TermLength = ExpansionProduct(LiftLength, Lift, CrossLength, Cross, Term);
+		SumLength = ExpansionSum(SumLength, Sum[Current], TermLength, Term, Sum[1 - Current]);
+		Current = 1 - Current;
+	}
+
+	return(Sign(Sum[Current][SumLength - 1]));
+}
+
+int FilteredOrient2D(double ax, double ay, double bx, double by, double cx, double cy)
+{
+	double DetLeft = (ax - cx) * (by - cy);
+	double DetRight = (ay - cy) * (bx - cx);
+	double Determinant = DetLeft - DetRight;
+	double ErrorBound = Orient2DErrorBound * (fabs(DetLeft) + fabs(DetRight));
+	if((Determinant > ErrorBound) || (-Determinant > ErrorBound))
+	{
+		return(Sign(Determinant));
+	}
+
+	return(ExactOrient2D(ax, ay, bx, by, cx, cy));
+}
+
+int FilteredDot2D(double ax, double ay, double bx, double by, double cx, double cy)
+{
+	// NOTE(hugo) : Same shape as orient2d (a sum of two products of differences) so the same error bound holds
+	double XProduct = (ax - cx) * (bx - cx);
+	double YProduct = (ay - cy) * (by - cy);
+	double Dot = XProduct + YProduct;
+	double ErrorBound = Orient2DErrorBound * (fabs(XProduct) + fabs(YProduct));
+	if((Dot > ErrorBound) || (-Dot > ErrorBound))
+	{
+		return(Sign(Dot));
+	}
+
+	return(ExactDot2D(ax, ay, bx, by, cx, cy));
+}
+
+inline uint64_t SortKeyFromDouble(double Value)
+{
+	// NOTE(hugo) : For positive doubles the bit pattern is ordered like the value
+	Assert(Value >= 0.0);
+	uint64_t Key;
+	memcpy(&Key, &Value, sizeof(Key));
+	return(Key);
+}
+
+int FilteredInCircle(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+	double ADX = ax - dx;
+	double ADY = ay - dy;
+	double BDX = bx - dx;
+	double BDY = by - dy;
+	double CDX = cx - dx;
+	double CDY = cy - dy;
+
+	double BDXCDY = BDX * CDY;
+	double CDXBDY = CDX * BDY;
+	double ALift = ADX * ADX + ADY * ADY;
+
+	double CDXADY = CDX * ADY;
+	double ADXCDY = ADX * CDY;
+	double BLift = BDX * BDX + BDY * BDY;
+
+	double ADXBDY = ADX * BDY;
+	double BDXADY = BDX * ADY;
+	double CLift = CDX * CDX + CDY * CDY;
+
+	double Determinant = ALift * (BDXCDY - CDXBDY) + BLift * (CDXADY - ADXCDY) + CLift * (ADXBDY - BDXADY);
+	double Permanent = (fabs(BDXCDY) + fabs(CDXBDY)) * ALift
+		+ (fabs(CDXADY) + fabs(ADXCDY)) * BLift
+		+ (fabs(ADXBDY) + fabs(BDXADY)) * CLift;
+	double ErrorBound = InCircleErrorBound * Permanent;
+	if((Determinant > ErrorBound) || (-Determinant > ErrorBound))
+	{
+		return(Sign(Determinant));
+	}
+
+	return(ExactInCircle(ax, ay, bx, by, cx, cy, dx, dy));
+}
+
+/* ------------------------------
+ *         3D predicates
+ * ------------------------------ */
+
+/*
+ * NOTE(hugo) : Orient3D(a, b, c, d) is the 4x4 determinant of the rows (x, y, z, 1), brought down to
+ * det(a - d, b - d, c - d) : positive if d is below the plane of abc, abc being counter clockwise seen
+ * from above. InSphere(a, b, c, d, e) is the lifted 5x5 one, brought down to 4x4 around e : positive if e
+ * is inside the sphere through abcd when Orient3D(a, b, c, d) > 0. Same filter / exact split as in 2D.
+ */
+
+static const double Orient3DErrorBound = (7.0 + 56.0 * ExpansionEpsilon) * ExpansionEpsilon;
+static const double InSphereErrorBound = (16.0 + 224.0 * ExpansionEpsilon) * ExpansionEpsilon;
+
+int ExactOrient3DExpansion(double* a, double* b, double* c, double* d, double* H)
+{
+	// NOTE(hugo) : H must hold 192 components
+	double Diffs[3][3][2];
+	double* Points[3] = {a, b, c};
+	for(int i = 0; i < 3; ++i)
+	{
+		for(int Axis = 0; Axis < 3; ++Axis)
+		{
+			TwoDiff(Points[i][Axis], d[Axis], &Diffs[i][Axis][1], &Diffs[i][Axis][0]);
+		}
+	}
+
+	// NOTE(hugo) : det = az * cross(b, c) + bz * cross(c, a) + cz * cross(a, b), cross being the xy one
+	double Sum[2][192];
+	int SumLength = 0;
+	int Current = 0;
+	for(int i = 0; i < 3; ++i)
+	{
+		double* UZ = Diffs[i][2];
+		double* VX = Diffs[(i + 1) % 3][0];
+		double* VY = Diffs[(i + 1) % 3][1];
+		double* WX = Diffs[(i + 2) % 3][0];
+		double* WY = Diffs[(i + 2) % 3][1];
+
+		double VXWY[8], WXVY[8], Cross[16];
+		int VXWYLength = ExpansionProduct(2, VX, 2, WY, VXWY);
+		int WXVYLength = ExpansionProduct(2, WX, 2, VY, WXVY);
+		NegateExpansion(WXVYLength, WXVY);
+		int CrossLength = ExpansionSum(VXWYLength, VXWY, WXVYLength, WXVY, Cross);
+
+		double Term[64];
+		int TermLength = ExpansionProduct(CrossLength, Cross, 2, UZ, Term);
+		SumLength = ExpansionSum(SumLength, Sum[Current], TermLength, Term, Sum[1 - Current]);
+		Current = 1 - Current;
+	}
+
+	for(int i = 0; i < SumLength; ++i)
+	{
+		H[i] = Sum[Current][i];
+	}
+	return(SumLength);
+}
+
+int ExactOrient3D(double* a, double* b, double* c, double* d)
+{
+	double Determinant[192];
+	int DeterminantLength = ExactOrient3DExpansion(a, b, c, d, Determinant);
+
+	return(Sign(Determinant[DeterminantLength - 1]));
+}
+
+// NOTE(hugo) : The lifts have at most 24 components and the orient3d expansions 192, each of the 4 * 24
+// lift components scales one of those into 2 * 192 components. That is about 600 KB, far too much for
+// a thread stack, so the caller gives the memory.
+#define IN_SPHERE_SUM_LENGTH (4 * 24 * 2 * 192)
+#define IN_SPHERE_SCRATCH_COUNT (2 * IN_SPHERE_SUM_LENGTH)
+
+int ExactInSphere(double* a, double* b, double* c, double* d, double* e, double* Scratch)
+{
+	// NOTE(hugo) : det = dlift * O(a, b, c, e) - clift * O(d, a, b, e) + blift * O(c, d, a, e) - alift * O(b, c, d, e)
+	// with O the orient3d expansion. The products are too long for ExpansionProduct so each lift
+	// component scales O and goes straight in the sum. Scratch holds IN_SPHERE_SCRATCH_COUNT doubles.
+	double* Points[4] = {a, b, c, d};
+	double* Sum[2] = {Scratch, Scratch + IN_SPHERE_SUM_LENGTH};
+	int SumLength = 0;
+	int Current = 0;
+	for(int i = 0; i < 4; ++i)
+	{
+		double* P = Points[i];
+		double* Q = Points[(i + 1) % 4];
+		double* R = Points[(i + 2) % 4];
+		double* S = Points[(i + 3) % 4];
+
+		double Lift[24];
+		int LiftLength = 0;
+		for(int Axis = 0; Axis < 3; ++Axis)
+		{
+			double Diff[2], Square[8], NewLift[24];
+			TwoDiff(S[Axis], e[Axis], &Diff[1], &Diff[0]);
+			int SquareLength = ExpansionProduct(2, Diff, 2, Diff, Square);
+			LiftLength = ExpansionSum(LiftLength, Lift, SquareLength, Square, NewLift);
+			for(int k = 0; k < LiftLength; ++k)
+			{
+				Lift[k] = NewLift[k];
+			}
+		}
+
+		// NOTE(hugo) : S is the lifted point, PQR are the other three in cyclic order, the sign alternates
+		double Orient[192];
+		int OrientLength = ExactOrient3DExpansion(P, Q, R, e, Orient);
+		if((i % 2) == 1)
+		{
+			NegateExpansion(OrientLength, Orient);
+		}
+
+		for(int k = 0; k < LiftLength; ++k)
+		{
+			double Scaled[2 * 192];
+			int ScaledLength = ScaleExpansion(OrientLength, Orient, Lift[k], Scaled);
+			Assert(SumLength + ScaledLength <= IN_SPHERE_SUM_LENGTH);
+			SumLength = ExpansionSum(SumLength, Sum[Current], ScaledLength, Scaled, Sum[1 - Current]);
+			Current = 1 - Current;
+		}
+	}
+
+	return(Sign(Sum[Current][SumLength - 1]));
+}
+
+int FilteredOrient3D(double* a, double* b, double* c, double* d)
+{
+	double ADX = a[0] - d[0];
+	double BDX = b[0] - d[0];
+	double CDX = c[0] - d[0];
+	double ADY = a[1] - d[1];
+	double BDY = b[1] - d[1];
+	double CDY = c[1] - d[1];
+	double ADZ = a[2] - d[2];
+	double BDZ = b[2] - d[2];
+	double CDZ = c[2] - d[2];
+
+	double BDXCDY = BDX * CDY;
+	double CDXBDY = CDX * BDY;
+	double CDXADY = CDX * ADY;
+	double ADXCDY = ADX * CDY;
+	double ADXBDY = ADX * BDY;
+	double BDXADY = BDX * ADY;
+
+	double Determinant = ADZ * (BDXCDY - CDXBDY) + BDZ * (CDXADY - ADXCDY) + CDZ * (ADXBDY - BDXADY);
+	double Permanent = (fabs(BDXCDY) + fabs(CDXBDY)) * fabs(ADZ)
+		+ (fabs(CDXADY) + fabs(ADXCDY)) * fabs(BDZ)
+		+ (fabs(ADXBDY) + fabs(BDXADY)) * fabs(CDZ);
+	double ErrorBound = Orient3DErrorBound * Permanent;
+	if((Determinant > ErrorBound) || (-Determinant > ErrorBound))
+	{
+		return(Sign(Determinant));
+	}
+
+	return(ExactOrient3D(a, b, c, d));
+}
+
+int FilteredInSphere(double* a, double* b, double* c, double* d, double* e, double* Scratch)
+{
+	// NOTE(hugo) : Scratch is only touched by the exact fallback, see ExactInSphere
+	double AEX = a[0] - e[0];
+	double BEX = b[0] - e[0];
+	double CEX = c[0] - e[0];
+	double DEX = d[0] - e[0];
+	double AEY = a[1] - e[1];
+	double BEY = b[1] - e[1];
+	double CEY = c[1] - e[1];
+	double DEY = d[1] - e[1];
+	double AEZ = a[2] - e[2];
+	double BEZ = b[2] - e[2];
+	double CEZ = c[2] - e[2];
+	double DEZ = d[2] - e[2];
+
+	double AEXBEY = AEX * BEY;
+	double BEXAEY = BEX * AEY;
+	double AB = AEXBEY - BEXAEY;
+	double BEXCEY = BEX * CEY;
+	double CEXBEY = CEX * BEY;
+	double BC = BEXCEY - CEXBEY;
+	double CEXDEY = CEX * DEY;
+	double DEXCEY = DEX * CEY;
+	double CD = CEXDEY - DEXCEY;
+	double DEXAEY = DEX * AEY;
+	double AEXDEY = AEX * DEY;
+	double DA = DEXAEY - AEXDEY;
+	double AEXCEY = AEX * CEY;
+	double CEXAEY = CEX * AEY;
+	double AC = AEXCEY - CEXAEY;
+	double BEXDEY = BEX * DEY;
+	double DEXBEY = DEX * BEY;
+	double BD = BEXDEY - DEXBEY;
+
+	double ABC = AEZ * BC - BEZ * AC + CEZ * AB;
+	double BCD = BEZ * CD - CEZ * BD + DEZ * BC;
+	double CDA = CEZ * DA + DEZ * AC + AEZ * CD;
+	double DAB = DEZ * AB + AEZ * BD + BEZ * DA;
+
+	double ALift = AEX * AEX + AEY * AEY + AEZ * AEZ;
+	double BLift = BEX * BEX + BEY * BEY + BEZ * BEZ;
+	double CLift = CEX * CEX + CEY * CEY + CEZ * CEZ;
+	double DLift = DEX * DEX + DEY * DEY + DEZ * DEZ;
+
+	double Determinant = (DLift * ABC - CLift * DAB) + (BLift * CDA - ALift * BCD);
+
+	double AEZPlus = fabs(AEZ);
+	double BEZPlus = fabs(BEZ);
+	double CEZPlus = fabs(CEZ);
+	double DEZPlus = fabs(DEZ);
+	double AB2 = fabs(AEXBEY) + fabs(BEXAEY);
+	double BC2 = fabs(BEXCEY) + fabs(CEXBEY);
+	double CD2 = fabs(CEXDEY) + fabs(DEXCEY);
+	double DA2 = fabs(DEXAEY) + fabs(AEXDEY);
+	double AC2 = fabs(AEXCEY) + fabs(CEXAEY);
+	double BD2 = fabs(BEXDEY) + fabs(DEXBEY);
+	double Permanent = (CD2 * BEZPlus + BD2 * CEZPlus + BC2 * DEZPlus) * ALift
+		+ (DA2 * CEZPlus + AC2 * DEZPlus + CD2 * AEZPlus) * BLift
+		+ (AB2 * DEZPlus + BD2 * AEZPlus + DA2 * BEZPlus) * CLift
+		+ (BC2 * AEZPlus + AC2 * BEZPlus + AB2 * CEZPlus) * DLift;
+	double ErrorBound = InSphereErrorBound * Permanent;
+	if((Determinant > ErrorBound) || (-Determinant > ErrorBound))
+	{
+		return(Sign(Determinant));
+	}
+
+	return(ExactInSphere(a, b, c, d, e, Scratch));
+}
+
+/* ------------------------------
+ *            kernels
+ * ------------------------------ */
+
+struct kernel_i32
+{
+	// NOTE(hugo) : |x| < 2^29 so that coordinate differences fit in 31 bits, their products
+	// in an int64 and the in-circle determinant in an int128.
+	typedef int32_t coord;
+	typedef double real;
+	static const int64_t MaxCoordinate = (int64_t(1) << 29) - 1;
+
+	static bool IsInRange(coord x)
+	{
+		return((x <= MaxCoordinate) && (x >= -MaxCoordinate));
+	}
+
+	template<typename point>
+	static int Orient2D(point A, point B, point C)
+	{
+		int64_t Determinant = (int64_t(B.x) - A.x) * (int64_t(C.y) - A.y) - (int64_t(B.y) - A.y) * (int64_t(C.x) - A.x);
+		return(Sign(Determinant));
+	}
+
+	template<typename point>
+	static int InCircle(point A, point B, point C, point D)
+	{
+		int64_t ADX = int64_t(A.x) - D.x;
+		int64_t ADY = int64_t(A.y) - D.y;
+		int64_t BDX = int64_t(B.x) - D.x;
+		int64_t BDY = int64_t(B.y) - D.y;
+		int64_t CDX = int64_t(C.x) - D.x;
+		int64_t CDY = int64_t(C.y) - D.y;
+
+		int128 ALift = ADX * ADX + ADY * ADY;
+		int128 BLift = BDX * BDX + BDY * BDY;
+		int128 CLift = CDX * CDX + CDY * CDY;
+
+		int128 Determinant = ALift * (BDX * CDY - CDX * BDY)
+			+ BLift * (CDX * ADY - ADX * CDY)
+			+ CLift * (ADX * BDY - BDX * ADY);
+		return(Sign(Determinant));
+	}
+
+	template<typename point>
+	static int Dot2D(point A, point B, point C)
+	{
+		int64_t Dot = (int64_t(A.x) - C.x) * (int64_t(B.x) - C.x) + (int64_t(A.y) - C.y) * (int64_t(B.y) - C.y);
+		return(Sign(Dot));
+	}
+
+	template<typename point>
+	static int LinearSign(point A, point D, int WeightX, int WeightY)
+	{
+		// NOTE(hugo) : Sign of WeightX (D.x - A.x) + WeightY (D.y - A.y), the weights are -1, 0 or 1
+		int64_t Sum = WeightX * (int64_t(D.x) - A.x) + WeightY * (int64_t(D.y) - A.y);
+		return(Sign(Sum));
+	}
+
+	template<typename point>
+	static uint64_t SquaredDistanceKey(point A, point B)
+	{
+		int64_t DeltaX = int64_t(B.x) - A.x;
+		int64_t DeltaY = int64_t(B.y) - A.y;
+		return(uint64_t(DeltaX * DeltaX) + uint64_t(DeltaY * DeltaY));
+	}
+	static uint64_t CoordinateSortKey(coord x)
+	{
+		// NOTE(hugo) : Flipping the sign bit orders two's complement values like unsigned ones
+		return(uint64_t(int64_t(x)) ^ (uint64_t(1) << 63));
+	}
+};
+
+struct kernel_i64
+{
+	// NOTE(hugo) : |x| < 2^53 so that every coordinate is also exactly a double. Orient2D fits in an int128,
+	// InCircle does not (it needs ~220 bits) so it goes through the filtered double predicate.
+	typedef int64_t coord;
+	typedef double real;
+	static const int64_t MaxCoordinate = (int64_t(1) << 53) - 1;
+
+	static bool IsInRange(coord x)
+	{
+		return((x <= MaxCoordinate) && (x >= -MaxCoordinate));
+	}
+
+	template<typename point>
+	static int Orient2D(point A, point B, point C)
+	{
+		int128 Determinant = int128(B.x - A.x) * (C.y - A.y) - int128(B.y - A.y) * (C.x - A.x);
+		return(Sign(Determinant));
+	}
+
+	template<typename point>
+	static int InCircle(point A, point B, point C, point D)
+	{
+		return(FilteredInCircle(double(A.x), double(A.y), double(B.x), double(B.y), double(C.x), double(C.y), double(D.x), double(D.y)));
+	}
+
+	template<typename point>
+	static int Dot2D(point A, point B, point C)
+	{
+		int128 Dot = int128(A.x - C.x) * (B.x - C.x) + int128(A.y - C.y) * (B.y - C.y);
+		return(Sign(Dot));
+	}
+
+	template<typename point>
+	static int LinearSign(point A, point D, int WeightX, int WeightY)
+	{
+		// NOTE(hugo) : Sign of WeightX (D.x - A.x) + WeightY (D.y - A.y), the weights are -1, 0 or 1.
+		// The differences are below 2^54, their sum fits in an int64.
+		int64_t Sum = WeightX * (D.x - A.x) + WeightY * (D.y - A.y);
+		return(Sign(Sum));
+	}
+
+	template<typename point>
+	static uint64_t SquaredDistanceKey(point A, point B)
+	{
+		double DeltaX = double(B.x - A.x);
+		double DeltaY = double(B.y - A.y);
+		return(SortKeyFromDouble(DeltaX * DeltaX + DeltaY * DeltaY));
+	}
+	static uint64_t CoordinateSortKey(coord x)
+	{
+		// NOTE(hugo) : Flipping the sign bit orders two's complement values like unsigned ones
+		return(uint64_t(int64_t(x)) ^ (uint64_t(1) << 63));
+	}
+};
+
+struct kernel_f64
+{
+	// NOTE(hugo) : 0 or 2^-100 <= |x| <= 2^100. The predicates are evaluated in floating point and only
+	// fall back to exact arithmetic when the result is too close to zero to be trusted. The in-circle
+	// terms are products of four differences : within this range neither them nor the error terms
+	// of the exact expansions can overflow or underflow.
+	typedef double coord;
+	typedef double real;
+	static constexpr double MaxCoordinate = 1267650600228229401496703205376.0; // NOTE(hugo) : 2^100
+
+	static bool IsInRange(coord x)
+	{
+		double Magnitude = fabs(x);
+		return((x == 0.0) || ((Magnitude <= MaxCoordinate) && (Magnitude * MaxCoordinate >= 1.0)));
+	}
+
+	template<typename point>
+	static int Orient2D(point A, point B, point C)
+	{
+		// NOTE(hugo) : Shewchuk's orient2d is computed around C, which is the same determinant
+		return(FilteredOrient2D(A.x, A.y, B.x, B.y, C.x, C.y));
+	}
+
+	template<typename point>
+	static int InCircle(point A, point B, point C, point D)
+	{
+		return(FilteredInCircle(A.x, A.y, B.x, B.y, C.x, C.y, D.x, D.y));
+	}
+
+	template<typename point>
+	static int Dot2D(point A, point B, point C)
+	{
+		return(FilteredDot2D(A.x, A.y, B.x, B.y, C.x, C.y));
+	}
+
+	template<typename point>
+	static int LinearSign(point A, point D, int WeightX, int WeightY)
+	{
+		// NOTE(hugo) : Sign of WeightX (D.x - A.x) + WeightY (D.y - A.y), the weights are -1, 0 or 1 so
+		// the products are exact. Only the symbolic super vertices need it, it always goes exact.
+		return(ExactSumOfDifferences(WeightX * D.x, WeightX * A.x, WeightY * D.y, WeightY * A.y));
+	}
+
+	template<typename point>
+	static uint64_t SquaredDistanceKey(point A, point B)
+	{
+		double DeltaX = B.x - A.x;
+		double DeltaY = B.y - A.y;
+		return(SortKeyFromDouble(DeltaX * DeltaX + DeltaY * DeltaY));
+	}
+	static uint64_t CoordinateSortKey(coord x)
+	{
+		// NOTE(hugo) : The bits of negative doubles are reversed so that they sort below the positive ones,
+		// -0 is folded on +0 first since they are the same coordinate
+		x = x + 0.0;
+		uint64_t Key;
+		memcpy(&Key, &x, sizeof(Key));
+		uint64_t SignBit = uint64_t(1) << 63;
+		return((Key & SignBit) ? ~Key : (Key | SignBit));
+	}
+};
+
+#endif
@@ -0,0 +1,438 @@
+/* ------------------------------
+ *        compact mesh
+ * ------------------------------ */
+
+/*
+ * NOTE(hugo) : Once the triangulation is done, FinalizeTriangulation turns it into a compact_mesh :
+ *   - the super triangle vertices and every triangle touching them are gone
+ *   - vertices and triangles are renumbered along a Hilbert curve, so that elements that are
+ *     close in the plane are also close in memory
+ *   - triangles are counter clockwise and know their neighbours, the convex hull is given as a loop
+ *   - the triangulation itself is left as it was, so vertices can still be inserted in it and it can be
+ *     finalized again later
+ */
+
+template<typename kernel>
+struct compact_mesh
+{
+	// NOTE(hugo) : x0, y0, x1, y1, ...
+	typename kernel::coord Positions[2 * MAX_POINT_COUNT];
+	// NOTE(hugo) : Index of each mesh vertex in the triangulation it comes from
+	int SourceVertexIndices[MAX_POINT_COUNT];
+	int VertexCount;
+
+	// NOTE(hugo) : Counter clockwise, 3 per triangle
+	int TriangleVertexIndices[3 * 2 * MAX_POINT_COUNT];
+	// NOTE(hugo) : Neighbour i is across the edge opposite to vertex i, -1 on the hull
+	int TriangleNeighbourIndices[3 * 2 * MAX_POINT_COUNT];
+	int TriangleCount;
+
+	// NOTE(hugo) : Counter clockwise, aligned vertices on the hull are kept
+	int HullVertexIndices[MAX_POINT_COUNT];
+	int HullVertexCount;
+};
+
+uint32_t HilbertIndex(uint32_t x, uint32_t y)
+{
+	// NOTE(hugo) : Position of (x, y) along the Hilbert curve filling a 2^16 x 2^16 grid
+	uint32_t Side = 1 << 16;
+	uint32_t Result = 0;
+	for(uint32_t s = Side / 2; s > 0; s /= 2)
+	{
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		Result += s * s * ((3 * rx) ^ ry);
+		if(ry == 0)
+		{
+			if(rx == 1)
+			{
+				x = Side - 1 - x;
+				y = Side - 1 - y;
+			}
+			uint32_t Temp = x;
+			x = y;
+			y = Temp;
+		}
+	}
+
+	return(Result);
+}
+
+template<typename kernel>
+struct hilbert_frame
+{
+	typename kernel::real MinX;
+	typename kernel::real MinY;
+	typename kernel::real Scale;
+};
+
+template<typename kernel>
+uint32_t HilbertIndex(hilbert_frame<kernel> Frame, typename kernel::real x, typename kernel::real y)
+{
+	uint32_t GridX = (uint32_t)((x - Frame.MinX) * Frame.Scale);
+	uint32_t GridY = (uint32_t)((y - Frame.MinY) * Frame.Scale);
+
+	return(HilbertIndex(GridX, GridY));
+}
+
+template<typename kernel>
+bool IsRealTriangle(triangulation<kernel>* T, int TriangleIndex)
+{
+	triangle F = T->Triangles[TriangleIndex];
+	bool Result = (T->Vertices[F.Vertex0Index].IsRealPoint
+		&& T->Vertices[F.Vertex1Index].IsRealPoint
+		&& T->Vertices[F.Vertex2Index].IsRealPoint);
+
+	return(Result);
+}
+
+template<typename kernel>
+void OrientedTriangleVertices(triangulation<kernel>* T, int TriangleIndex, int* VertexIndices)
+{
+	triangle F = T->Triangles[TriangleIndex];
+	VertexIndices[0] = F.Vertex0Index;
+	VertexIndices[1] = F.Vertex1Index;
+	VertexIndices[2] = F.Vertex2Index;
+	if(!IsCounterClockWise(T->Vertices[F.Vertex0Index], T->Vertices[F.Vertex1Index], T->Vertices[F.Vertex2Index]))
+	{
+		VertexIndices[1] = F.Vertex2Index;
+		VertexIndices[2] = F.Vertex1Index;
+	}
+}
+
+template<typename kernel>
+int FindRealNeighbour(triangulation<kernel>* T, int TriangleIndex, int PIndex, int QIndex)
+{
+	// NOTE(hugo) : The real triangle across the edge PQ of the given triangle, -1 if there is none
+	int EdgeIndex = FindEdgeIndexLinkingVertices(T, PIndex, QIndex, T->Triangles[TriangleIndex]);
+	int F0Index = 0;
+	int F1Index = 0;
+	if(GetTrianglesOfEdge(T, EdgeIndex, &F0Index, &F1Index))
+	{
+		int NeighbourIndex = (F0Index == TriangleIndex) ? F1Index : F0Index;
+		if(IsRealTriangle(T, NeighbourIndex))
+		{
+			return(NeighbourIndex);
+		}
+	}
+
+	return(-1);
+}
+
+template<typename kernel>
+int BuildRealBoundary(triangulation<kernel>* T, int* NextBoundaryVertexIndices)
+{
+	// NOTE(hugo) : The boundary of the real triangles, as the next vertex when turning counter clockwise.
+	// Returns one vertex of the boundary or -1 if there is no real triangle.
+	int FirstBoundaryVertexIndex = -1;
+	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	{
+		NextBoundaryVertexIndices[VertexIndex] = -1;
+	}
+
+	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
+	{
+		if(!IsRealTriangle(T, TriangleIndex))
+		{
+			continue;
+		}
+
+		int VertexIndices[3];
+		OrientedTriangleVertices(T, TriangleIndex, VertexIndices);
+		for(int i = 0; i < 3; ++i)
+		{
+			int PIndex = VertexIndices[(i + 1) % 3];
+			int QIndex = VertexIndices[(i + 2) % 3];
+			if(FindRealNeighbour(T, TriangleIndex, PIndex, QIndex) == -1)
+			{
+				NextBoundaryVertexIndices[PIndex] = QIndex;
+				FirstBoundaryVertexIndex = PIndex;
+			}
+		}
+	}
+
+	return(FirstBoundaryVertexIndex);
+}
+
+template<typename kernel>
+void CopyTriangulation(triangulation<kernel>* Dest, triangulation<kernel>* Source)
+{
+	// NOTE(hugo) : Only the part in use, a whole triangulation is mostly free room
+	Assert(Source->VertexCount <= Dest->MaxVertexCount);
+	Dest->VertexCount = Source->VertexCount;
+	Dest->EdgeCount = Source->EdgeCount;
+	Dest->TriangleCount = Source->TriangleCount;
+	memcpy(Dest->Vertices, Source->Vertices, Source->VertexCount * sizeof(Source->Vertices[0]));
+	memcpy(Dest->VertexTriangleIndices, Source->VertexTriangleIndices, Source->VertexCount * sizeof(Source->VertexTriangleIndices[0]));
+	memcpy(Dest->Edges, Source->Edges, Source->EdgeCount * sizeof(Source->Edges[0]));
+	memcpy(Dest->Triangles, Source->Triangles, Source->TriangleCount * sizeof(Source->Triangles[0]));
+}
+
+template<typename kernel>
+triangulation<kernel>* CompleteConvexHull(triangulation<kernel>* T, triangulation<kernel>* Scratch)
+{
+	// NOTE(hugo) : The super triangle is not infinitely far away, so when hull vertices are almost aligned
+	// the triangle linking them may use a fake vertex instead and the real triangles do not cover the hull.
+	// Along a thin strip of points they can even be cut in several pieces, so the hull is computed on its own
+	// (monotone chain, aligned vertices kept) and every hull edge missing from the real boundary is forced.
+	// With all the hull edges in, no triangle inside the hull can reach a fake vertex.
+	// A forced hull edge is not always Delaunay with respect to the fake vertices, so T could not take more
+	// vertices afterwards. The edges are forced in a copy of T made in Scratch, which is returned, and T is
+	// returned as is when it already holds the whole hull.
+	sort_entry SortEntries[MAX_POINT_COUNT];
+	sort_entry SortTemp[MAX_POINT_COUNT];
+	int SortCount = 0;
+	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	{
+		if(T->Vertices[VertexIndex].IsRealPoint)
+		{
+			SortEntries[SortCount].SortKey = kernel::CoordinateSortKey(T->Vertices[VertexIndex].y);
+			SortEntries[SortCount].Index = VertexIndex;
+			SortCount++;
+		}
+	}
+	if(SortCount < 3)
+	{
+		return(T);
+	}
+
+	// NOTE(hugo) : MergeSort is stable, sorting on y then on x gives the (x, y) order
+	MergeSort(SortCount, SortEntries, SortTemp);
+	for(int i = 0; i < SortCount; ++i)
+	{
+		SortEntries[i].SortKey = kernel::CoordinateSortKey(T->Vertices[SortEntries[i].Index].x);
+	}
+	MergeSort(SortCount, SortEntries, SortTemp);
+
+	vertex<kernel> First = T->Vertices[SortEntries[0].Index];
+	vertex<kernel> Last = T->Vertices[SortEntries[SortCount - 1].Index];
+	bool AllAligned = true;
+	for(int i = 1; (i < SortCount - 1) && AllAligned; ++i)
+	{
+		AllAligned = (Orientation(First, Last, T->Vertices[SortEntries[i].Index]) == 0);
+	}
+	if(AllAligned)
+	{
+		return(T);
+	}
+
+	// NOTE(hugo) : Lower hull from left to right, then upper hull back, only clockwise turns are removed
+	int HullVertexIndices[2 * MAX_POINT_COUNT];
+	int HullVertexCount = 0;
+	for(int i = 0; i < SortCount; ++i)
+	{
+		vertex<kernel> V = T->Vertices[SortEntries[i].Index];
+		while((HullVertexCount >= 2)
+				&& (Orientation(T->Vertices[HullVertexIndices[HullVertexCount - 2]], T->Vertices[HullVertexIndices[HullVertexCount - 1]], V) < 0))
+		{
+			HullVertexCount--;
+		}
+		HullVertexIndices[HullVertexCount++] = SortEntries[i].Index;
+	}
+	int LowerHullVertexCount = HullVertexCount;
+	for(int i = SortCount - 2; i >= 0; --i)
+	{
+		vertex<kernel> V = T->Vertices[SortEntries[i].Index];
+		while((HullVertexCount > LowerHullVertexCount)
+				&& (Orientation(T->Vertices[HullVertexIndices[HullVertexCount - 2]], T->Vertices[HullVertexIndices[HullVertexCount - 1]], V) < 0))
+		{
+			HullVertexCount--;
+		}
+		HullVertexIndices[HullVertexCount++] = SortEntries[i].Index;
+	}
+	// NOTE(hugo) : The first vertex closes the loop
+	HullVertexCount--;
+
+	int NextBoundaryVertexIndices[MAX_POINT_COUNT];
+	BuildRealBoundary(T, NextBoundaryVertexIndices);
+	triangulation<kernel>* Result = T;
+	for(int i = 0; i < HullVertexCount; ++i)
+	{
+		int PIndex = HullVertexIndices[i];
+		int QIndex = HullVertexIndices[(i + 1) % HullVertexCount];
+		if(NextBoundaryVertexIndices[PIndex] != QIndex)
+		{
+			if(Result == T)
+			{
+				CopyTriangulation(Scratch, T);
+				Result = Scratch;
+			}
+			bool Inserted = InsertConstraint(Result, PIndex, QIndex);
+			Assert(Inserted);
+		}
+	}
+
+	return(Result);
+}
+
+template<typename kernel>
+void FinalizeTriangulation(triangulation<kernel>* Source, compact_mesh<kernel>* Mesh, triangulation<kernel>* Scratch)
+{
+	// NOTE(hugo) : Source is never modified, it can take more vertices and constraints and be finalized again.
+	// Scratch is only written when hull edges have to be forced, its previous content does not matter.
+	// The mesh and the hull scratch arrays are sized for MAX_POINT_COUNT vertices.
+	typedef typename kernel::real real;
+	Assert(Source->VertexCount <= MAX_POINT_COUNT);
+
+	triangulation<kernel>* T = CompleteConvexHull(Source, Scratch);
+
+	sort_entry SortEntries[2 * MAX_POINT_COUNT];
+	sort_entry SortTemp[2 * MAX_POINT_COUNT];
+	int NewVertexIndices[MAX_POINT_COUNT];
+	int NewTriangleIndices[2 * MAX_POINT_COUNT];
+
+	// NOTE(hugo) : Bounding box of the real vertices, mapped on the Hilbert grid
+	hilbert_frame<kernel> Frame = {};
+	real MaxX = 0;
+	real MaxY = 0;
+	bool FoundRealVertex = false;
+	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	{
+		vertex<kernel> V = T->Vertices[VertexIndex];
+		if(V.IsRealPoint)
+		{
+			if(!FoundRealVertex)
+			{
+				Frame.MinX = MaxX = real(V.x);
+				Frame.MinY = MaxY = real(V.y);
+				FoundRealVertex = true;
+			}
+			Frame.MinX = (real(V.x) < Frame.MinX) ? real(V.x) : Frame.MinX;
+			Frame.MinY = (real(V.y) < Frame.MinY) ? real(V.y) : Frame.MinY;
+			MaxX = (real(V.x) > MaxX) ? real(V.x) : MaxX;
+			MaxY = (real(V.y) > MaxY) ? real(V.y) : MaxY;
+		}
+	}
+	real Extent = ((MaxX - Frame.MinX) > (MaxY - Frame.MinY)) ? (MaxX - Frame.MinX) : (MaxY - Frame.MinY);
+	Frame.Scale = (Extent > 0) ? (real(65535) / Extent) : real(0);
+
+	// NOTE(hugo) : Vertices
+	int SortCount = 0;
+	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	{
+		vertex<kernel> V = T->Vertices[VertexIndex];
+		NewVertexIndices[VertexIndex] = -1;
+		if(V.IsRealPoint)
+		{
+			sort_entry* Entry = SortEntries + SortCount++;
+			Entry->SortKey = HilbertIndex(Frame, real(V.x), real(V.y));
+			Entry->Index = VertexIndex;
+		}
+	}
+	MergeSort(SortCount, SortEntries, SortTemp);
+
+	Mesh->VertexCount = SortCount;
+	for(int NewIndex = 0; NewIndex < SortCount; ++NewIndex)
+	{
+		int VertexIndex = SortEntries[NewIndex].Index;
+		vertex<kernel> V = T->Vertices[VertexIndex];
+		NewVertexIndices[VertexIndex] = NewIndex;
+		Mesh->Positions[2 * NewIndex + 0] = V.x;
+		Mesh->Positions[2 * NewIndex + 1] = V.y;
+		Mesh->SourceVertexIndices[NewIndex] = VertexIndex;
+	}
+
+	// NOTE(hugo) : Triangles, sorted by the Hilbert index of their centroid
+	SortCount = 0;
+	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
+	{
+		NewTriangleIndices[TriangleIndex] = -1;
+		if(IsRealTriangle(T, TriangleIndex))
+		{
+			triangle F = T->Triangles[TriangleIndex];
+			vertex<kernel> A = T->Vertices[F.Vertex0Index];
+			vertex<kernel> B = T->Vertices[F.Vertex1Index];
+			vertex<kernel> C = T->Vertices[F.Vertex2Index];
+			real CentroidX = (real(A.x) + real(B.x) + real(C.x)) / real(3);
+			real CentroidY = (real(A.y) + real(B.y) + real(C.y)) / real(3);
+
+			sort_entry* Entry = SortEntries + SortCount++;
+			Entry->SortKey = HilbertIndex(Frame, CentroidX, CentroidY);
+			Entry->Index = TriangleIndex;
+		}
+	}
+	MergeSort(SortCount, SortEntries, SortTemp);
+
+	Mesh->TriangleCount = SortCount;
+	for(int NewIndex = 0; NewIndex < SortCount; ++NewIndex)
+	{
+		NewTriangleIndices[SortEntries[NewIndex].Index] = NewIndex;
+	}
+	for(int NewIndex = 0; NewIndex < SortCount; ++NewIndex)
+	{
+		int TriangleIndex = SortEntries[NewIndex].Index;
+		int VertexIndices[3];
+		OrientedTriangleVertices(T, TriangleIndex, VertexIndices);
+		for(int i = 0; i < 3; ++i)
+		{
+			int NeighbourIndex = FindRealNeighbour(T, TriangleIndex, VertexIndices[(i + 1) % 3], VertexIndices[(i + 2) % 3]);
+			Mesh->TriangleVertexIndices[3 * NewIndex + i] = NewVertexIndices[VertexIndices[i]];
+			Mesh->TriangleNeighbourIndices[3 * NewIndex + i] = (NeighbourIndex == -1) ? -1 : NewTriangleIndices[NeighbourIndex];
+		}
+	}
+
+	// NOTE(hugo) : Hull, starting from its vertex with the smallest index
+	int NextHullVertexIndices[MAX_POINT_COUNT];
+	Mesh->HullVertexCount = 0;
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		NextHullVertexIndices[VertexIndex] = -1;
+	}
+	for(int TriangleIndex = 0; TriangleIndex < Mesh->TriangleCount; ++TriangleIndex)
+	{
+		int* VertexIndices = Mesh->TriangleVertexIndices + 3 * TriangleIndex;
+		for(int i = 0; i < 3; ++i)
+		{
+			if(Mesh->TriangleNeighbourIndices[3 * TriangleIndex + i] == -1)
+			{
+				NextHullVertexIndices[VertexIndices[(i + 1) % 3]] = VertexIndices[(i + 2) % 3];
+			}
+		}
+	}
+	int FirstHullVertexIndex = -1;
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		if(NextHullVertexIndices[VertexIndex] != -1)
+		{
+			FirstHullVertexIndex = VertexIndex;
+			break;
+		}
+	}
+	if(FirstHullVertexIndex != -1)
+	{
+		int VertexIndex = FirstHullVertexIndex;
+		do
+		{
+			Assert(Mesh->HullVertexCount < ArrayCount(Mesh->HullVertexIndices));
+			Mesh->HullVertexIndices[Mesh->HullVertexCount++] = VertexIndex;
+			VertexIndex = NextHullVertexIndices[VertexIndex];
+		} while(VertexIndex != FirstHullVertexIndex);
+	}
+}
+
+uint64_t HashBytes(uint64_t Hash, void* Data, size_t Size)
+{
+	// NOTE(hugo) : FNV-1a
+	uint8_t* Bytes = (uint8_t*)Data;
+	for(size_t i = 0; i < Size; ++i)
+	{
+		Hash ^= Bytes[i];
+		Hash *= 1099511628211ULL;
+	}
+
+	return(Hash);
+}
+
+template<typename kernel>
+uint64_t HashCompactMesh(compact_mesh<kernel>* Mesh)
+{
+	// NOTE(hugo) : The numbering of a finalized mesh only depends on its geometry, so two runs
+	// producing the same triangulation produce the same hash.
+	uint64_t Hash = 14695981039346656037ULL;
+	Hash = HashBytes(Hash, Mesh->Positions, 2 * Mesh->VertexCount * sizeof(Mesh->Positions[0]));
+	Hash = HashBytes(Hash, Mesh->TriangleVertexIndices, 3 * Mesh->TriangleCount * sizeof(Mesh->TriangleVertexIndices[0]));
+	Hash = HashBytes(Hash, Mesh->TriangleNeighbourIndices, 3 * Mesh->TriangleCount * sizeof(Mesh->TriangleNeighbourIndices[0]));
+	Hash = HashBytes(Hash, Mesh->HullVertexIndices, Mesh->HullVertexCount * sizeof(Mesh->HullVertexIndices[0]));
+
+	return(Hash);
+}
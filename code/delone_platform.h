@@ -0,0 +1,31 @@
+#if !defined(DELONE_PLATFORM_H)
+#define DELONE_PLATFORM_H
+
+// NOTE(hugo) : The macros and helpers every file of the program relies on, so that each header can be included on its own
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ArrayCount(x) (sizeof((x))/(sizeof((x)[0])))
+#define Assert(x) do{if(!(x)){*(int*)0=0;}}while(0)
+
+// NOTE(hugo) : Hands out the pieces of a block allocated once, nothing is ever freed on its own
+struct memory_arena
+{
+	uint8_t* Base;
+	size_t Size;
+	size_t Used;
+};
+
+#define PushArray(Arena, Count, type) (type*)PushSize_(Arena, (size_t)(Count) * sizeof(type))
+inline void* PushSize_(memory_arena* Arena, size_t Size)
+{
+	// NOTE(hugo) : 16 bytes aligned
+	size_t Start = (Arena->Used + 15) & ~(size_t)15;
+	Assert(Start + Size <= Arena->Size);
+	Arena->Used = Start + Size;
+
+	return(Arena->Base + Start);
+}
+
+#endif
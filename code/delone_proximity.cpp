@@ -0,0 +1,475 @@
+/* ------------------------------
+ *       proximity graphs
+ * ------------------------------ */
+
+/*
+ * NOTE(hugo) : The Euclidean minimum spanning tree, the relative neighbourhood graph and the Gabriel graph
+ * are all subgraphs of the Delaunay triangulation (EMST <= RNG <= GG <= DT), so they are extracted
+ * from its edges instead of from all the pairs of points. They read the compact_mesh given by
+ * FinalizeTriangulation and never touch the triangulation. Vertex indices are the ones of the mesh,
+ * a mesh without triangles (all its points aligned) gives no edge.
+ */
+
+struct edge_list
+{
+	// NOTE(hugo) : Two vertex indices per edge
+	int VertexIndices[2 * 3 * MAX_POINT_COUNT];
+	int EdgeCount;
+};
+
+struct mesh_edges
+{
+	// NOTE(hugo) : Every edge of the mesh once, with the vertices of the (at most two) triangles facing it, -1 on the hull
+	int VertexIndices[2 * 3 * MAX_POINT_COUNT];
+	int FacingVertexIndices[2 * 3 * MAX_POINT_COUNT];
+	int EdgeCount;
+};
+
+struct vertex_stars
+{
+	// NOTE(hugo) : The neighbours of vertex i are NeighbourIndices[Offsets[i]] to NeighbourIndices[Offsets[i + 1] - 1]
+	int Offsets[MAX_POINT_COUNT + 1];
+	int NeighbourIndices[2 * 3 * MAX_POINT_COUNT];
+};
+
+void PushEdgeToList(edge_list* List, int AIndex, int BIndex)
+{
+	Assert(List->EdgeCount < ArrayCount(List->VertexIndices) / 2);
+	List->VertexIndices[2 * List->EdgeCount + 0] = AIndex;
+	List->VertexIndices[2 * List->EdgeCount + 1] = BIndex;
+	List->EdgeCount++;
+}
+
+template<typename kernel>
+vertex<kernel> GetMeshVertex(compact_mesh<kernel>* Mesh, int VertexIndex)
+{
+	vertex<kernel> Result = {Mesh->Positions[2 * VertexIndex + 0], Mesh->Positions[2 * VertexIndex + 1], true};
+
+	return(Result);
+}
+
+template<typename kernel>
+void BuildMeshEdges(compact_mesh<kernel>* Mesh, mesh_edges* Edges)
+{
+	// NOTE(hugo) : An inner edge is seen from both of its triangles, only the one with the lower index keeps it
+	Edges->EdgeCount = 0;
+	for(int TriangleIndex = 0; TriangleIndex < Mesh->TriangleCount; ++TriangleIndex)
+	{
+		int* VertexIndices = Mesh->TriangleVertexIndices + 3 * TriangleIndex;
+		for(int i = 0; i < 3; ++i)
+		{
+			int NeighbourIndex = Mesh->TriangleNeighbourIndices[3 * TriangleIndex + i];
+			if((NeighbourIndex != -1) && (NeighbourIndex < TriangleIndex))
+			{
+				continue;
+			}
+
+			int FacingVertexIndex = -1;
+			if(NeighbourIndex != -1)
+			{
+				for(int j = 0; j < 3; ++j)
+				{
+					if(Mesh->TriangleNeighbourIndices[3 * NeighbourIndex + j] == TriangleIndex)
+					{
+						FacingVertexIndex = Mesh->TriangleVertexIndices[3 * NeighbourIndex + j];
+					}
+				}
+				Assert(FacingVertexIndex != -1);
+			}
+
+			Assert(Edges->EdgeCount < ArrayCount(Edges->VertexIndices) / 2);
+			int EdgeIndex = Edges->EdgeCount++;
+			Edges->VertexIndices[2 * EdgeIndex + 0] = VertexIndices[(i + 1) % 3];
+			Edges->VertexIndices[2 * EdgeIndex + 1] = VertexIndices[(i + 2) % 3];
+			Edges->FacingVertexIndices[2 * EdgeIndex + 0] = VertexIndices[i];
+			Edges->FacingVertexIndices[2 * EdgeIndex + 1] = FacingVertexIndex;
+		}
+	}
+}
+
+void BuildVertexStars(mesh_edges* Edges, int VertexCount, vertex_stars* Stars)
+{
+	for(int VertexIndex = 0; VertexIndex <= VertexCount; ++VertexIndex)
+	{
+		Stars->Offsets[VertexIndex] = 0;
+	}
+	for(int EdgeIndex = 0; EdgeIndex < Edges->EdgeCount; ++EdgeIndex)
+	{
+		Stars->Offsets[Edges->VertexIndices[2 * EdgeIndex + 0] + 1]++;
+		Stars->Offsets[Edges->VertexIndices[2 * EdgeIndex + 1] + 1]++;
+	}
+	for(int VertexIndex = 0; VertexIndex < VertexCount; ++VertexIndex)
+	{
+		Stars->Offsets[VertexIndex + 1] += Stars->Offsets[VertexIndex];
+	}
+
+	// NOTE(hugo) : Offsets[i] is used as the write cursor of vertex i, then shifted back
+	for(int EdgeIndex = 0; EdgeIndex < Edges->EdgeCount; ++EdgeIndex)
+	{
+		int PIndex = Edges->VertexIndices[2 * EdgeIndex + 0];
+		int QIndex = Edges->VertexIndices[2 * EdgeIndex + 1];
+		Stars->NeighbourIndices[Stars->Offsets[PIndex]++] = QIndex;
+		Stars->NeighbourIndices[Stars->Offsets[QIndex]++] = PIndex;
+	}
+	for(int VertexIndex = VertexCount; VertexIndex > 0; --VertexIndex)
+	{
+		Stars->Offsets[VertexIndex] = Stars->Offsets[VertexIndex - 1];
+	}
+	Stars->Offsets[0] = 0;
+}
+
+int FindSetRoot(int* Parents, int Index)
+{
+	// NOTE(hugo) : Path halving
+	while(Parents[Index] != Index)
+	{
+		Parents[Index] = Parents[Parents[Index]];
+		Index = Parents[Index];
+	}
+
+	return(Index);
+}
+
+template<typename kernel>
+void MarkEuclideanMinimumSpanningTree(compact_mesh<kernel>* Mesh, mesh_edges* Edges, bool* IsTreeEdge)
+{
+	// NOTE(hugo) : Kruskal over the Delaunay edges sorted by length. At most 3n edges, sorting them is
+	// the O(n log n) part, the union-find is close to linear.
+	sort_entry SortEntries[3 * MAX_POINT_COUNT];
+	sort_entry SortTemp[3 * MAX_POINT_COUNT];
+	for(int EdgeIndex = 0; EdgeIndex < Edges->EdgeCount; ++EdgeIndex)
+	{
+		vertex<kernel> P = GetMeshVertex(Mesh, Edges->VertexIndices[2 * EdgeIndex + 0]);
+		vertex<kernel> Q = GetMeshVertex(Mesh, Edges->VertexIndices[2 * EdgeIndex + 1]);
+		SortEntries[EdgeIndex].SortKey = kernel::SquaredDistanceKey(P, Q);
+		SortEntries[EdgeIndex].Index = EdgeIndex;
+		IsTreeEdge[EdgeIndex] = false;
+	}
+	// NOTE(hugo) : Serial on purpose : at most 3 * MAX_POINT_COUNT edges, under the size where ParallelMergeSort
+	// would split the work anyway
+	MergeSort(Edges->EdgeCount, SortEntries, SortTemp);
+
+	int Parents[MAX_POINT_COUNT];
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		Parents[VertexIndex] = VertexIndex;
+	}
+
+	int TreeEdgeCount = 0;
+	for(int SortIndex = 0; (SortIndex < Edges->EdgeCount) && (TreeEdgeCount < Mesh->VertexCount - 1); ++SortIndex)
+	{
+		int EdgeIndex = SortEntries[SortIndex].Index;
+		int Root0 = FindSetRoot(Parents, Edges->VertexIndices[2 * EdgeIndex + 0]);
+		int Root1 = FindSetRoot(Parents, Edges->VertexIndices[2 * EdgeIndex + 1]);
+		if(Root0 != Root1)
+		{
+			Parents[Root0] = Root1;
+			IsTreeEdge[EdgeIndex] = true;
+			TreeEdgeCount++;
+		}
+	}
+}
+
+template<typename kernel>
+void ExtractEuclideanMinimumSpanningTree(compact_mesh<kernel>* Mesh, edge_list* Tree)
+{
+	mesh_edges Edges;
+	bool IsTreeEdge[3 * MAX_POINT_COUNT];
+	BuildMeshEdges(Mesh, &Edges);
+	MarkEuclideanMinimumSpanningTree(Mesh, &Edges, IsTreeEdge);
+
+	Tree->EdgeCount = 0;
+	for(int EdgeIndex = 0; EdgeIndex < Edges.EdgeCount; ++EdgeIndex)
+	{
+		if(IsTreeEdge[EdgeIndex])
+		{
+			PushEdgeToList(Tree, Edges.VertexIndices[2 * EdgeIndex + 0], Edges.VertexIndices[2 * EdgeIndex + 1]);
+		}
+	}
+}
+
+template<typename kernel>
+bool IsGabrielEdge(compact_mesh<kernel>* Mesh, mesh_edges* Edges, int EdgeIndex)
+{
+	// NOTE(hugo) : A Delaunay edge is a Gabriel edge iff the closed disk of diameter PQ holds none of the
+	// (at most two) vertices facing it, no other vertex can be in there without being one of them.
+	vertex<kernel> P = GetMeshVertex(Mesh, Edges->VertexIndices[2 * EdgeIndex + 0]);
+	vertex<kernel> Q = GetMeshVertex(Mesh, Edges->VertexIndices[2 * EdgeIndex + 1]);
+	for(int i = 0; i < 2; ++i)
+	{
+		int FacingVertexIndex = Edges->FacingVertexIndices[2 * EdgeIndex + i];
+		if((FacingVertexIndex != -1) && (kernel::Dot2D(P, Q, GetMeshVertex(Mesh, FacingVertexIndex)) <= 0))
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+template<typename kernel>
+void ExtractGabrielGraph(compact_mesh<kernel>* Mesh, edge_list* Graph)
+{
+	mesh_edges Edges;
+	BuildMeshEdges(Mesh, &Edges);
+
+	Graph->EdgeCount = 0;
+	for(int EdgeIndex = 0; EdgeIndex < Edges.EdgeCount; ++EdgeIndex)
+	{
+		if(IsGabrielEdge(Mesh, &Edges, EdgeIndex))
+		{
+			PushEdgeToList(Graph, Edges.VertexIndices[2 * EdgeIndex + 0], Edges.VertexIndices[2 * EdgeIndex + 1]);
+		}
+	}
+}
+
+template<typename kernel>
+bool IsInLune(compact_mesh<kernel>* Mesh, int PIndex, int QIndex, int RIndex)
+{
+	// NOTE(hugo) : Is R strictly closer to both P and Q than they are to each other ?
+	vertex<kernel> P = GetMeshVertex(Mesh, PIndex);
+	vertex<kernel> Q = GetMeshVertex(Mesh, QIndex);
+	vertex<kernel> R = GetMeshVertex(Mesh, RIndex);
+	uint64_t PQ = kernel::SquaredDistanceKey(P, Q);
+	bool Result = ((RIndex != PIndex) && (RIndex != QIndex)
+		&& (kernel::SquaredDistanceKey(P, R) < PQ) && (kernel::SquaredDistanceKey(Q, R) < PQ));
+
+	return(Result);
+}
+
+#define MESH_BOX_LEAF_SIZE 8
+#define MAX_MESH_BOX_COUNT (4 * ((MAX_POINT_COUNT + MESH_BOX_LEAF_SIZE - 1) / MESH_BOX_LEAF_SIZE))
+
+template<typename kernel>
+struct mesh_box_tree
+{
+	// NOTE(hugo) : Bounding boxes of runs of MESH_BOX_LEAF_SIZE consecutive mesh vertices, which are compact since
+	// the mesh is Hilbert ordered. Box 1 is the root and the children of box i are 2i and 2i + 1. Leaf j is box
+	// LeafCount + j, LeafCount is a power of two and the leaves past the last vertex are empty (Min > Max).
+	typename kernel::coord MinX[MAX_MESH_BOX_COUNT];
+	typename kernel::coord MinY[MAX_MESH_BOX_COUNT];
+	typename kernel::coord MaxX[MAX_MESH_BOX_COUNT];
+	typename kernel::coord MaxY[MAX_MESH_BOX_COUNT];
+	int LeafCount;
+};
+
+template<typename kernel>
+void BuildMeshBoxTree(compact_mesh<kernel>* Mesh, mesh_box_tree<kernel>* Tree)
+{
+	typedef typename kernel::coord coord;
+
+	Tree->LeafCount = 1;
+	while(Tree->LeafCount * MESH_BOX_LEAF_SIZE < Mesh->VertexCount)
+	{
+		Tree->LeafCount *= 2;
+	}
+	Assert(2 * Tree->LeafCount <= ArrayCount(Tree->MinX));
+
+	for(int LeafIndex = 0; LeafIndex < Tree->LeafCount; ++LeafIndex)
+	{
+		int BoxIndex = Tree->LeafCount + LeafIndex;
+		int FirstVertexIndex = LeafIndex * MESH_BOX_LEAF_SIZE;
+		int OnePastLastVertexIndex = FirstVertexIndex + MESH_BOX_LEAF_SIZE;
+		OnePastLastVertexIndex = (OnePastLastVertexIndex < Mesh->VertexCount) ? OnePastLastVertexIndex : Mesh->VertexCount;
+		if(FirstVertexIndex >= OnePastLastVertexIndex)
+		{
+			Tree->MinX[BoxIndex] = Tree->MinY[BoxIndex] = coord(1);
+			Tree->MaxX[BoxIndex] = Tree->MaxY[BoxIndex] = coord(0);
+			continue;
+		}
+
+		Tree->MinX[BoxIndex] = Tree->MaxX[BoxIndex] = Mesh->Positions[2 * FirstVertexIndex + 0];
+		Tree->MinY[BoxIndex] = Tree->MaxY[BoxIndex] = Mesh->Positions[2 * FirstVertexIndex + 1];
+		for(int VertexIndex = FirstVertexIndex + 1; VertexIndex < OnePastLastVertexIndex; ++VertexIndex)
+		{
+			coord x = Mesh->Positions[2 * VertexIndex + 0];
+			coord y = Mesh->Positions[2 * VertexIndex + 1];
+			Tree->MinX[BoxIndex] = (x < Tree->MinX[BoxIndex]) ? x : Tree->MinX[BoxIndex];
+			Tree->MinY[BoxIndex] = (y < Tree->MinY[BoxIndex]) ? y : Tree->MinY[BoxIndex];
+			Tree->MaxX[BoxIndex] = (x > Tree->MaxX[BoxIndex]) ? x : Tree->MaxX[BoxIndex];
+			Tree->MaxY[BoxIndex] = (y > Tree->MaxY[BoxIndex]) ? y : Tree->MaxY[BoxIndex];
+		}
+	}
+
+	for(int BoxIndex = Tree->LeafCount - 1; BoxIndex >= 1; --BoxIndex)
+	{
+		int Child0 = 2 * BoxIndex;
+		int Child1 = 2 * BoxIndex + 1;
+		if(Tree->MinX[Child1] > Tree->MaxX[Child1])
+		{
+			Tree->MinX[BoxIndex] = Tree->MinX[Child0];
+			Tree->MinY[BoxIndex] = Tree->MinY[Child0];
+			Tree->MaxX[BoxIndex] = Tree->MaxX[Child0];
+			Tree->MaxY[BoxIndex] = Tree->MaxY[Child0];
+			continue;
+		}
+		Tree->MinX[BoxIndex] = (Tree->MinX[Child0] < Tree->MinX[Child1]) ? Tree->MinX[Child0] : Tree->MinX[Child1];
+		Tree->MinY[BoxIndex] = (Tree->MinY[Child0] < Tree->MinY[Child1]) ? Tree->MinY[Child0] : Tree->MinY[Child1];
+		Tree->MaxX[BoxIndex] = (Tree->MaxX[Child0] > Tree->MaxX[Child1]) ? Tree->MaxX[Child0] : Tree->MaxX[Child1];
+		Tree->MaxY[BoxIndex] = (Tree->MaxY[Child0] > Tree->MaxY[Child1]) ? Tree->MaxY[Child0] : Tree->MaxY[Child1];
+	}
+}
+
+template<typename kernel>
+uint64_t SquaredDistanceKeyToBox(mesh_box_tree<kernel>* Tree, int BoxIndex, vertex<kernel> P)
+{
+	// NOTE(hugo) : Distance to the closest point of the box. Clamping only brings each delta closer to zero,
+	// so the key is never above the one of a vertex in the box, rounding included.
+	vertex<kernel> Closest = P;
+	Closest.x = (Closest.x < Tree->MinX[BoxIndex]) ? Tree->MinX[BoxIndex] : Closest.x;
+	Closest.x = (Closest.x > Tree->MaxX[BoxIndex]) ? Tree->MaxX[BoxIndex] : Closest.x;
+	Closest.y = (Closest.y < Tree->MinY[BoxIndex]) ? Tree->MinY[BoxIndex] : Closest.y;
+	Closest.y = (Closest.y > Tree->MaxY[BoxIndex]) ? Tree->MaxY[BoxIndex] : Closest.y;
+
+	return(kernel::SquaredDistanceKey(P, Closest));
+}
+
+template<typename kernel>
+bool IsLuneEmpty(compact_mesh<kernel>* Mesh, mesh_box_tree<kernel>* Tree, int PIndex, int QIndex)
+{
+	// NOTE(hugo) : The lune is the intersection of the disks of radius |PQ| around P and around Q, a box is only
+	// opened when it gets strictly inside both of them.
+	vertex<kernel> P = GetMeshVertex(Mesh, PIndex);
+	vertex<kernel> Q = GetMeshVertex(Mesh, QIndex);
+	uint64_t PQ = kernel::SquaredDistanceKey(P, Q);
+
+	// NOTE(hugo) : Depth first, one pending sibling per level at most
+	int BoxStack[64];
+	int BoxStackCount = 0;
+	BoxStack[BoxStackCount++] = 1;
+	while(BoxStackCount > 0)
+	{
+		int BoxIndex = BoxStack[--BoxStackCount];
+		if((Tree->MinX[BoxIndex] > Tree->MaxX[BoxIndex])
+				|| (SquaredDistanceKeyToBox(Tree, BoxIndex, P) >= PQ)
+				|| (SquaredDistanceKeyToBox(Tree, BoxIndex, Q) >= PQ))
+		{
+			continue;
+		}
+
+		if(BoxIndex >= Tree->LeafCount)
+		{
+			int FirstVertexIndex = (BoxIndex - Tree->LeafCount) * MESH_BOX_LEAF_SIZE;
+			int OnePastLastVertexIndex = FirstVertexIndex + MESH_BOX_LEAF_SIZE;
+			OnePastLastVertexIndex = (OnePastLastVertexIndex < Mesh->VertexCount) ? OnePastLastVertexIndex : Mesh->VertexCount;
+			for(int VertexIndex = FirstVertexIndex; VertexIndex < OnePastLastVertexIndex; ++VertexIndex)
+			{
+				if(IsInLune(Mesh, PIndex, QIndex, VertexIndex))
+				{
+					return(false);
+				}
+			}
+		}
+		else
+		{
+			Assert(BoxStackCount + 2 <= ArrayCount(BoxStack));
+			BoxStack[BoxStackCount++] = 2 * BoxIndex;
+			BoxStack[BoxStackCount++] = 2 * BoxIndex + 1;
+		}
+	}
+
+	return(true);
+}
+
+template<typename kernel>
+void ExtractRelativeNeighbourhoodGraph(compact_mesh<kernel>* Mesh, edge_list* Graph)
+{
+	// NOTE(hugo) : EMST edges are RNG edges and need no test. The other candidates are the Gabriel edges
+	// whose lune is empty. Looking only at the Delaunay neighbours of P and Q is not enough (a lune can hold
+	// vertices that are walled off from both), so the lune is searched in a box tree over the Hilbert ordered
+	// vertices. A box is skipped as soon as it stays out of one of the two disks bounding the lune, which holds
+	// even when the lune is huge and empty, like between two long parallel rows : each row touches one of the
+	// disks only at P or Q. Cost : O(n log n) for the EMST, then about log n boxes per candidate edge.
+	mesh_edges Edges;
+	bool IsTreeEdge[3 * MAX_POINT_COUNT];
+	mesh_box_tree<kernel> Tree;
+	BuildMeshEdges(Mesh, &Edges);
+	MarkEuclideanMinimumSpanningTree(Mesh, &Edges, IsTreeEdge);
+	BuildMeshBoxTree(Mesh, &Tree);
+
+	Graph->EdgeCount = 0;
+	for(int EdgeIndex = 0; EdgeIndex < Edges.EdgeCount; ++EdgeIndex)
+	{
+		int PIndex = Edges.VertexIndices[2 * EdgeIndex + 0];
+		int QIndex = Edges.VertexIndices[2 * EdgeIndex + 1];
+		if(IsTreeEdge[EdgeIndex]
+				|| (IsGabrielEdge(Mesh, &Edges, EdgeIndex) && IsLuneEmpty(Mesh, &Tree, PIndex, QIndex)))
+		{
+			PushEdgeToList(Graph, PIndex, QIndex);
+		}
+	}
+}
+
+#define MAX_NEAREST_NEIGHBOUR_COUNT 32
+
+template<typename kernel>
+void ExtractApproximateNearestNeighbours(compact_mesh<kernel>* Mesh, int NeighbourCount, int* NeighbourIndices)
+{
+	// NOTE(hugo) : For each vertex, the NeighbourCount closest vertices among its star and the stars of its
+	// neighbours, closest first. NeighbourIndices holds NeighbourCount indices per mesh vertex, padded
+	// with -1. The nearest neighbour is always exact since it is a Delaunay neighbour, the farther ones
+	// are approximate.
+	Assert(NeighbourCount <= MAX_NEAREST_NEIGHBOUR_COUNT);
+
+	mesh_edges Edges;
+	vertex_stars Stars;
+	BuildMeshEdges(Mesh, &Edges);
+	BuildVertexStars(&Edges, Mesh->VertexCount, &Stars);
+
+	int LastVisitor[MAX_POINT_COUNT];
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		LastVisitor[VertexIndex] = -1;
+	}
+
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		int* Result = NeighbourIndices + NeighbourCount * VertexIndex;
+		uint64_t ResultKeys[MAX_NEAREST_NEIGHBOUR_COUNT];
+		int ResultCount = 0;
+		for(int i = 0; i < NeighbourCount; ++i)
+		{
+			Result[i] = -1;
+		}
+
+		vertex<kernel> V = GetMeshVertex(Mesh, VertexIndex);
+		LastVisitor[VertexIndex] = VertexIndex;
+		for(int StarIndex = Stars.Offsets[VertexIndex]; StarIndex < Stars.Offsets[VertexIndex + 1]; ++StarIndex)
+		{
+			int RingIndex = Stars.NeighbourIndices[StarIndex];
+			// NOTE(hugo) : First the neighbour itself, then its own star
+			for(int CandidateStarIndex = Stars.Offsets[RingIndex] - 1; CandidateStarIndex < Stars.Offsets[RingIndex + 1]; ++CandidateStarIndex)
+			{
+				int CandidateIndex = (CandidateStarIndex < Stars.Offsets[RingIndex]) ? RingIndex : Stars.NeighbourIndices[CandidateStarIndex];
+				if(LastVisitor[CandidateIndex] == VertexIndex)
+				{
+					continue;
+				}
+				LastVisitor[CandidateIndex] = VertexIndex;
+
+				// NOTE(hugo) : Insertion in the sorted list of the best ones
+				uint64_t Key = kernel::SquaredDistanceKey(V, GetMeshVertex(Mesh, CandidateIndex));
+				int InsertIndex = ResultCount;
+				while((InsertIndex > 0) && (ResultKeys[InsertIndex - 1] > Key))
+				{
+					--InsertIndex;
+				}
+				if(InsertIndex < NeighbourCount)
+				{
+					int LastIndex = (ResultCount < NeighbourCount) ? ResultCount : (NeighbourCount - 1);
+					for(int i = LastIndex; i > InsertIndex; --i)
+					{
+						ResultKeys[i] = ResultKeys[i - 1];
+						Result[i] = Result[i - 1];
+					}
+					ResultKeys[InsertIndex] = Key;
+					Result[InsertIndex] = CandidateIndex;
+					if(ResultCount < NeighbourCount)
+					{
+						ResultCount++;
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,495 @@
+/* ------------------------------
+ *   interpolation rasterizer
+ * ------------------------------ */
+
+/*
+ * NOTE(hugo) : RasterizeInterpolation fills a regular grid with the interpolation of values attached
+ * to the vertices of a finalized mesh (a DEM from survey points for instance).
+ *   - the grid is cut in tiles handed out to the threads, each tile owns its pixels. Triangles are binned
+ *     to the tiles their bounding box overlaps before the threads start, so a tile only sees its own triangles
+ *   - in a tile, every triangle overlapping it is scanned row by row. Barycentric weights are affine,
+ *     so the linear interpolant is stepped along the row and written 4 pixels at a time (SSE2)
+ *   - natural neighbour (Sibson) interpolation builds, per pixel, the cavity the pixel center would
+ *     carve if inserted and weights the vertices by the Voronoi area it would steal (Watson's
+ *     formulation). It is a lot slower than the linear one and only C1 away from the data points.
+ * Pixels outside of the convex hull get NoDataValue.
+ */
+
+enum interpolation_mode
+{
+	Interpolation_Linear,
+	Interpolation_NaturalNeighbour,
+};
+
+struct raster_grid
+{
+	// NOTE(hugo) : Width * Height values, row by row, owned by the caller. The center of
+	// pixel (i, j) is (OriginX + (i + 0.5) * CellSize, OriginY + (j + 0.5) * CellSize).
+	float* Values;
+	int Width;
+	int Height;
+	double OriginX;
+	double OriginY;
+	double CellSize;
+	float NoDataValue;
+};
+
+#define RASTER_TILE_SIZE 128
+#define MAX_CAVITY_TRIANGLE_COUNT 256
+
+struct raster_triangle
+{
+	// NOTE(hugo) : Everything in pixel space, where pixel (i, j) is centered on (i, j)
+	double x[3];
+	double y[3];
+	int MinX, MinY, MaxX, MaxY;
+
+	// NOTE(hugo) : Value(x, y) = Value0 + dValuedX * (x - x[0]) + dValuedY * (y - y[0])
+	double Value0;
+	double dValuedX;
+	double dValuedY;
+};
+
+template<typename kernel>
+struct raster_job
+{
+	compact_mesh<kernel>* Mesh;
+	raster_grid* Grid;
+	interpolation_mode Mode;
+
+	float MeshValues[MAX_POINT_COUNT];
+	raster_triangle Triangles[2 * MAX_POINT_COUNT];
+
+	int TileCountX;
+	int TileCount;
+	SDL_atomic_t NextTileIndex;
+
+	// NOTE(hugo) : The triangles of tile i are TileTriangleIndices[TileTriangleOffsets[i]] to
+	// TileTriangleIndices[TileTriangleOffsets[i + 1] - 1], in increasing order
+	int* TileTriangleOffsets;
+	int* TileTriangleIndices;
+};
+
+bool Circumcenter(double ax, double ay, double bx, double by, double cx, double cy, double* x, double* y)
+{
+	// NOTE(hugo) : Computed relative to A. False if A, B and C are (close to) aligned.
+	double bax = bx - ax;
+	double bay = by - ay;
+	double cax = cx - ax;
+	double cay = cy - ay;
+	double D = 2.0 * (bax * cay - bay * cax);
+	double BA = bax * bax + bay * bay;
+	double CA = cax * cax + cay * cay;
+	if(fabs(D) <= 1e-12 * (BA + CA))
+	{
+		return(false);
+	}
+	*x = ax + (cay * BA - bay * CA) / D;
+	*y = ay + (bax * CA - cax * BA) / D;
+
+	return(true);
+}
+
+template<typename kernel>
+float NaturalNeighbourValue(raster_job<kernel>* Job, int StartTriangleIndex, double x, double y, float LinearValue)
+{
+	compact_mesh<kernel>* Mesh = Job->Mesh;
+
+	// NOTE(hugo) : Cavity of (x, y), i.e. the triangles whose circumcircle contains it, grown from the one containing it
+	int CavityTriangleIndices[MAX_CAVITY_TRIANGLE_COUNT];
+	int CavityTriangleCount = 0;
+	CavityTriangleIndices[CavityTriangleCount++] = StartTriangleIndex;
+	for(int CavityIndex = 0; CavityIndex < CavityTriangleCount; ++CavityIndex)
+	{
+		int TriangleIndex = CavityTriangleIndices[CavityIndex];
+		for(int i = 0; i < 3; ++i)
+		{
+			int NeighbourIndex = Mesh->TriangleNeighbourIndices[3 * TriangleIndex + i];
+			if(NeighbourIndex == -1)
+			{
+				continue;
+			}
+			bool IsAlreadyInCavity = false;
+			for(int OtherIndex = 0; OtherIndex < CavityTriangleCount; ++OtherIndex)
+			{
+				if(CavityTriangleIndices[OtherIndex] == NeighbourIndex)
+				{
+					IsAlreadyInCavity = true;
+					break;
+				}
+			}
+			if(IsAlreadyInCavity)
+			{
+				continue;
+			}
+
+			double px[3];
+			double py[3];
+			for(int j = 0; j < 3; ++j)
+			{
+				int VertexIndex = Mesh->TriangleVertexIndices[3 * NeighbourIndex + j];
+				px[j] = (double)Mesh->Positions[2 * VertexIndex + 0] - x;
+				py[j] = (double)Mesh->Positions[2 * VertexIndex + 1] - y;
+			}
+			double InCircle =
+				(px[0] * px[0] + py[0] * py[0]) * (px[1] * py[2] - px[2] * py[1]) +
+				(px[1] * px[1] + py[1] * py[1]) * (px[2] * py[0] - px[0] * py[2]) +
+				(px[2] * px[2] + py[2] * py[2]) * (px[0] * py[1] - px[1] * py[0]);
+			if(InCircle > 0.0)
+			{
+				if(CavityTriangleCount == MAX_CAVITY_TRIANGLE_COUNT)
+				{
+					return(LinearValue);
+				}
+				CavityTriangleIndices[CavityTriangleCount++] = NeighbourIndex;
+			}
+		}
+	}
+
+	// NOTE(hugo) : Each cavity triangle ABC gives to A the signed area spanned by its old
+	// Voronoi vertex (circumcenter of ABC) and the new ones of (x, y) with AB and with CA.
+	double WeightSum = 0.0;
+	double ValueSum = 0.0;
+	for(int CavityIndex = 0; CavityIndex < CavityTriangleCount; ++CavityIndex)
+	{
+		int* VertexIndices = Mesh->TriangleVertexIndices + 3 * CavityTriangleIndices[CavityIndex];
+		double px[3];
+		double py[3];
+		for(int i = 0; i < 3; ++i)
+		{
+			px[i] = (double)Mesh->Positions[2 * VertexIndices[i] + 0] - x;
+			py[i] = (double)Mesh->Positions[2 * VertexIndices[i] + 1] - y;
+		}
+
+		double CenterX;
+		double CenterY;
+		double NewCenterX[3];
+		double NewCenterY[3];
+		if(!Circumcenter(px[0], py[0], px[1], py[1], px[2], py[2], &CenterX, &CenterY))
+		{
+			return(LinearValue);
+		}
+		for(int i = 0; i < 3; ++i)
+		{
+			// NOTE(hugo) : The new Voronoi vertex facing vertex i, (x, y) being the origin
+			if(!Circumcenter(0.0, 0.0, px[(i + 1) % 3], py[(i + 1) % 3], px[(i + 2) % 3], py[(i + 2) % 3], NewCenterX + i, NewCenterY + i))
+			{
+				return(LinearValue);
+			}
+		}
+		for(int i = 0; i < 3; ++i)
+		{
+			int j1 = (i + 1) % 3;
+			int j2 = (i + 2) % 3;
+			double Weight = (NewCenterX[j1] - CenterX) * (NewCenterY[j2] - CenterY)
+				- (NewCenterX[j2] - CenterX) * (NewCenterY[j1] - CenterY);
+			WeightSum += Weight;
+			ValueSum += Weight * Job->MeshValues[VertexIndices[i]];
+		}
+	}
+	if(WeightSum <= 0.0)
+	{
+		return(LinearValue);
+	}
+
+	return((float)(ValueSum / WeightSum));
+}
+
+template<typename kernel>
+void RasterizeTriangleInTile(raster_job<kernel>* Job, int TriangleIndex, int TileMinX, int TileMinY, int TileMaxX, int TileMaxY)
+{
+	raster_grid* Grid = Job->Grid;
+	raster_triangle* Triangle = Job->Triangles + TriangleIndex;
+
+	int MinY = (Triangle->MinY > TileMinY) ? Triangle->MinY : TileMinY;
+	int MaxY = (Triangle->MaxY < TileMaxY) ? Triangle->MaxY : TileMaxY;
+	int MinX = (Triangle->MinX > TileMinX) ? Triangle->MinX : TileMinX;
+	int MaxX = (Triangle->MaxX < TileMaxX) ? Triangle->MaxX : TileMaxX;
+
+	// NOTE(hugo) : Edge i goes from vertex i to vertex i + 1 and the triangle is counter clockwise,
+	// so inside means EdgeX[i] * x + EdgeRow[i] >= 0 for all i. EdgeRow is stepped from row to row.
+	// The test is slightly widened so that pixel centers on a shared edge are never dropped by both triangles.
+	double EdgeX[3];
+	double EdgeRow[3];
+	double EdgeRowStep[3];
+	double EdgeEpsilon[3];
+	for(int i = 0; i < 3; ++i)
+	{
+		int Next = (i + 1) % 3;
+		double dx = Triangle->x[Next] - Triangle->x[i];
+		double dy = Triangle->y[Next] - Triangle->y[i];
+		EdgeX[i] = -dy;
+		EdgeRow[i] = dx * (MinY - Triangle->y[i]) + dy * Triangle->x[i];
+		EdgeRowStep[i] = dx;
+		EdgeEpsilon[i] = 1e-9 * (fabs(dx) + fabs(dy));
+	}
+
+	for(int y = MinY; y <= MaxY; ++y)
+	{
+		double SpanMinX = MinX;
+		double SpanMaxX = MaxX;
+		for(int i = 0; i < 3; ++i)
+		{
+			double Bound = -(EdgeRow[i] + EdgeEpsilon[i]);
+			if(EdgeX[i] > 0.0)
+			{
+				double Min = Bound / EdgeX[i];
+				SpanMinX = (Min > SpanMinX) ? Min : SpanMinX;
+			}
+			else if(EdgeX[i] < 0.0)
+			{
+				double Max = Bound / EdgeX[i];
+				SpanMaxX = (Max < SpanMaxX) ? Max : SpanMaxX;
+			}
+			else if(Bound > 0.0)
+			{
+				SpanMaxX = SpanMinX - 1.0;
+			}
+			EdgeRow[i] += EdgeRowStep[i];
+		}
+
+		int x0 = (int)ceil(SpanMinX);
+		int x1 = (int)floor(SpanMaxX);
+		if(x0 > x1)
+		{
+			continue;
+		}
+
+		float* Row = Grid->Values + (size_t)y * Grid->Width;
+		double RowValue = Triangle->Value0 + Triangle->dValuedX * (x0 - Triangle->x[0]) + Triangle->dValuedY * (y - Triangle->y[0]);
+		if(Job->Mode == Interpolation_Linear)
+		{
+			// NOTE(hugo) : Row[x0 + k] = RowValue + k * dValuedX, 4 pixels at a time
+			__m128 Base = _mm_set1_ps((float)RowValue);
+			__m128 Step = _mm_set1_ps((float)Triangle->dValuedX);
+			__m128 Offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+			__m128 Four = _mm_set1_ps(4.0f);
+			int x = x0;
+			for(; x + 3 <= x1; x += 4)
+			{
+				_mm_storeu_ps(Row + x, _mm_add_ps(Base, _mm_mul_ps(Step, Offsets)));
+				Offsets = _mm_add_ps(Offsets, Four);
+			}
+			for(; x <= x1; ++x)
+			{
+				Row[x] = (float)(RowValue + Triangle->dValuedX * (x - x0));
+			}
+		}
+		else
+		{
+			double WorldY = Grid->OriginY + (y + 0.5) * Grid->CellSize;
+			for(int x = x0; x <= x1; ++x)
+			{
+				double WorldX = Grid->OriginX + (x + 0.5) * Grid->CellSize;
+				float LinearValue = (float)(RowValue + Triangle->dValuedX * (x - x0));
+				Row[x] = NaturalNeighbourValue(Job, TriangleIndex, WorldX, WorldY, LinearValue);
+			}
+		}
+	}
+}
+
+template<typename kernel>
+void DoRasterTiles(int ThreadIndex, void* Data)
+{
+	raster_job<kernel>* Job = (raster_job<kernel>*)Data;
+	raster_grid* Grid = Job->Grid;
+	for(;;)
+	{
+		int TileIndex = SDL_AtomicAdd(&Job->NextTileIndex, 1);
+		if(TileIndex >= Job->TileCount)
+		{
+			break;
+		}
+
+		int TileMinX = RASTER_TILE_SIZE * (TileIndex % Job->TileCountX);
+		int TileMinY = RASTER_TILE_SIZE * (TileIndex / Job->TileCountX);
+		int TileMaxX = TileMinX + RASTER_TILE_SIZE - 1;
+		int TileMaxY = TileMinY + RASTER_TILE_SIZE - 1;
+		TileMaxX = (TileMaxX < Grid->Width - 1) ? TileMaxX : (Grid->Width - 1);
+		TileMaxY = (TileMaxY < Grid->Height - 1) ? TileMaxY : (Grid->Height - 1);
+
+		for(int y = TileMinY; y <= TileMaxY; ++y)
+		{
+			float* Row = Grid->Values + (size_t)y * Grid->Width;
+			for(int x = TileMinX; x <= TileMaxX; ++x)
+			{
+				Row[x] = Grid->NoDataValue;
+			}
+		}
+
+		for(int BinIndex = Job->TileTriangleOffsets[TileIndex]; BinIndex < Job->TileTriangleOffsets[TileIndex + 1]; ++BinIndex)
+		{
+			RasterizeTriangleInTile(Job, Job->TileTriangleIndices[BinIndex], TileMinX, TileMinY, TileMaxX, TileMaxY);
+		}
+	}
+}
+
+template<typename kernel>
+bool GetTriangleTileRange(raster_job<kernel>* Job, int TriangleIndex, int* TileMinX, int* TileMinY, int* TileMaxX, int* TileMaxY)
+{
+	// NOTE(hugo) : The tiles overlapped by the bounding box of the triangle, false if it misses the grid
+	raster_grid* Grid = Job->Grid;
+	raster_triangle* Triangle = Job->Triangles + TriangleIndex;
+	if((Triangle->MaxX < 0) || (Triangle->MinX > Grid->Width - 1) || (Triangle->MaxY < 0) || (Triangle->MinY > Grid->Height - 1))
+	{
+		return(false);
+	}
+
+	*TileMinX = ((Triangle->MinX > 0) ? Triangle->MinX : 0) / RASTER_TILE_SIZE;
+	*TileMinY = ((Triangle->MinY > 0) ? Triangle->MinY : 0) / RASTER_TILE_SIZE;
+	*TileMaxX = ((Triangle->MaxX < Grid->Width - 1) ? Triangle->MaxX : (Grid->Width - 1)) / RASTER_TILE_SIZE;
+	*TileMaxY = ((Triangle->MaxY < Grid->Height - 1) ? Triangle->MaxY : (Grid->Height - 1)) / RASTER_TILE_SIZE;
+
+	return(true);
+}
+
+template<typename kernel>
+bool BinTrianglesToTiles(raster_job<kernel>* Job)
+{
+	// NOTE(hugo) : Counting, prefix sum, then filling with TileTriangleOffsets[i] as the write cursor of tile i.
+	// False if the bins could not be allocated.
+	int* Offsets = Job->TileTriangleOffsets;
+	for(int TileIndex = 0; TileIndex <= Job->TileCount; ++TileIndex)
+	{
+		Offsets[TileIndex] = 0;
+	}
+	for(int TriangleIndex = 0; TriangleIndex < Job->Mesh->TriangleCount; ++TriangleIndex)
+	{
+		int TileMinX, TileMinY, TileMaxX, TileMaxY;
+		if(GetTriangleTileRange(Job, TriangleIndex, &TileMinX, &TileMinY, &TileMaxX, &TileMaxY))
+		{
+			for(int TileY = TileMinY; TileY <= TileMaxY; ++TileY)
+			{
+				for(int TileX = TileMinX; TileX <= TileMaxX; ++TileX)
+				{
+					Offsets[TileY * Job->TileCountX + TileX + 1]++;
+				}
+			}
+		}
+	}
+	for(int TileIndex = 0; TileIndex < Job->TileCount; ++TileIndex)
+	{
+		Offsets[TileIndex + 1] += Offsets[TileIndex];
+	}
+
+	Job->TileTriangleIndices = (int*)malloc(((size_t)Offsets[Job->TileCount] + 1) * sizeof(int));
+	if(!Job->TileTriangleIndices)
+	{
+		return(false);
+	}
+	for(int TriangleIndex = 0; TriangleIndex < Job->Mesh->TriangleCount; ++TriangleIndex)
+	{
+		int TileMinX, TileMinY, TileMaxX, TileMaxY;
+		if(GetTriangleTileRange(Job, TriangleIndex, &TileMinX, &TileMinY, &TileMaxX, &TileMaxY))
+		{
+			for(int TileY = TileMinY; TileY <= TileMaxY; ++TileY)
+			{
+				for(int TileX = TileMinX; TileX <= TileMaxX; ++TileX)
+				{
+					Job->TileTriangleIndices[Offsets[TileY * Job->TileCountX + TileX]++] = TriangleIndex;
+				}
+			}
+		}
+	}
+	for(int TileIndex = Job->TileCount; TileIndex > 0; --TileIndex)
+	{
+		Offsets[TileIndex] = Offsets[TileIndex - 1];
+	}
+	Offsets[0] = 0;
+
+	return(true);
+}
+
+template<typename kernel>
+bool RasterizeInterpolation(compact_mesh<kernel>* Mesh, float* VertexValues, raster_grid* Grid, interpolation_mode Mode, int ThreadCount)
+{
+	// NOTE(hugo) : VertexValues is indexed like the vertices of the triangulation the mesh was finalized from.
+	// False if the job could not be allocated, the grid is left untouched then.
+	Assert(Grid->CellSize > 0.0);
+
+	// NOTE(hugo) : On the heap, the per triangle setup is too big for the stack of the caller
+	raster_job<kernel>* Job = (raster_job<kernel>*)malloc(sizeof(raster_job<kernel>));
+	if(!Job)
+	{
+		return(false);
+	}
+	Job->Mesh = Mesh;
+	Job->Grid = Grid;
+	Job->Mode = Mode;
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		Job->MeshValues[VertexIndex] = VertexValues[Mesh->SourceVertexIndices[VertexIndex]];
+	}
+
+	for(int TriangleIndex = 0; TriangleIndex < Mesh->TriangleCount; ++TriangleIndex)
+	{
+		raster_triangle* Triangle = Job->Triangles + TriangleIndex;
+		double Values[3];
+		for(int i = 0; i < 3; ++i)
+		{
+			int VertexIndex = Mesh->TriangleVertexIndices[3 * TriangleIndex + i];
+			Triangle->x[i] = ((double)Mesh->Positions[2 * VertexIndex + 0] - Grid->OriginX) / Grid->CellSize - 0.5;
+			Triangle->y[i] = ((double)Mesh->Positions[2 * VertexIndex + 1] - Grid->OriginY) / Grid->CellSize - 0.5;
+			Values[i] = Job->MeshValues[VertexIndex];
+		}
+
+		double MinX = Triangle->x[0];
+		double MaxX = Triangle->x[0];
+		double MinY = Triangle->y[0];
+		double MaxY = Triangle->y[0];
+		for(int i = 1; i < 3; ++i)
+		{
+			MinX = (Triangle->x[i] < MinX) ? Triangle->x[i] : MinX;
+			MaxX = (Triangle->x[i] > MaxX) ? Triangle->x[i] : MaxX;
+			MinY = (Triangle->y[i] < MinY) ? Triangle->y[i] : MinY;
+			MaxY = (Triangle->y[i] > MaxY) ? Triangle->y[i] : MaxY;
+		}
+		// NOTE(hugo) : Clamped in double first, the pixel space coordinates can be way out of int range
+		Triangle->MinX = (int)fmax(ceil(MinX - 1.0), -1.0);
+		Triangle->MinY = (int)fmax(ceil(MinY - 1.0), -1.0);
+		Triangle->MaxX = (int)fmin(floor(MaxX + 1.0), (double)Grid->Width);
+		Triangle->MaxY = (int)fmin(floor(MaxY + 1.0), (double)Grid->Height);
+
+		double e1x = Triangle->x[1] - Triangle->x[0];
+		double e1y = Triangle->y[1] - Triangle->y[0];
+		double e2x = Triangle->x[2] - Triangle->x[0];
+		double e2y = Triangle->y[2] - Triangle->y[0];
+		double Det = e1x * e2y - e1y * e2x;
+		Triangle->Value0 = Values[0];
+		Triangle->dValuedX = ((Values[1] - Values[0]) * e2y - (Values[2] - Values[0]) * e1y) / Det;
+		Triangle->dValuedY = ((Values[2] - Values[0]) * e1x - (Values[1] - Values[0]) * e2x) / Det;
+	}
+
+	Job->TileCountX = (Grid->Width + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+	Job->TileCount = Job->TileCountX * ((Grid->Height + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE);
+	SDL_AtomicSet(&Job->NextTileIndex, 0);
+	Job->TileTriangleOffsets = (int*)malloc(((size_t)Job->TileCount + 1) * sizeof(int));
+	if(!Job->TileTriangleOffsets || !BinTrianglesToTiles(Job))
+	{
+		free(Job->TileTriangleOffsets);
+		free(Job);
+		return(false);
+	}
+
+	// NOTE(hugo) : One entry per thread, the tiles themselves are handed out by NextTileIndex
+	work_queue Queue = {};
+	if(ThreadCount < 1)
+	{
+		ThreadCount = 1;
+	}
+	if(ThreadCount > MAX_THREAD_COUNT)
+	{
+		ThreadCount = MAX_THREAD_COUNT;
+	}
+	for(int ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		AddWorkEntry(&Queue, DoRasterTiles<kernel>, Job);
+	}
+	CompleteAllWork(&Queue, ThreadCount);
+
+	free(Job->TileTriangleIndices);
+	free(Job->TileTriangleOffsets);
+	free(Job);
+
+	return(true);
+}
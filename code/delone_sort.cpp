@@ -0,0 +1,162 @@
+/* ------------------------------
+ *            sorting
+ * ------------------------------ */
+
+struct sort_entry
+{
+	uint64_t SortKey;
+	int Index;
+};
+
+void MergeSortedRuns(sort_entry* Run0, int Run0Count, sort_entry* Run1, int Run1Count, sort_entry* Out)
+{
+	// NOTE(hugo) : Stable, on equal keys the entry of the first run comes first
+	sort_entry* End0 = Run0 + Run0Count;
+	sort_entry* End1 = Run1 + Run1Count;
+	int Count = Run0Count + Run1Count;
+	for(int Index = 0; Index < Count; ++Index)
+	{
+		if(Run0 == End0)
+		{
+			*Out++ = *Run1++;
+		}
+		else if(Run1 == End1)
+		{
+			*Out++ = *Run0++;
+		}
+		else if(Run1->SortKey < Run0->SortKey)
+		{
+			*Out++ = *Run1++;
+		}
+		else
+		{
+			*Out++ = *Run0++;
+		}
+	}
+}
+
+void MergeSort(int Count, sort_entry* First, sort_entry* Temp)
+{
+	if(Count <= 1)
+	{
+		return;
+	}
+	if(Count == 2)
+	{
+		if(First[0].SortKey > First[1].SortKey)
+		{
+			sort_entry Swap = First[0];
+			First[0] = First[1];
+			First[1] = Swap;
+		}
+		return;
+	}
+
+	int Half0 = Count / 2;
+	int Half1 = Count - Half0;
+	MergeSort(Half0, First, Temp);
+	MergeSort(Half1, First + Half0, Temp);
+	MergeSortedRuns(First, Half0, First + Half0, Half1, Temp);
+
+	for(int Index = 0; Index < Count; ++Index)
+	{
+		First[Index] = Temp[Index];
+	}
+}
+
+struct sort_job
+{
+	// NOTE(hugo) : Either sorts Run0 in place (Run1Count < 0) or merges Run0 and Run1 into Out
+	sort_entry* Run0;
+	int Run0Count;
+	sort_entry* Run1;
+	int Run1Count;
+	sort_entry* Out;
+};
+
+void DoSortJob(int ThreadIndex, void* Data)
+{
+	sort_job* Job = (sort_job*)Data;
+	if(Job->Run1Count < 0)
+	{
+		MergeSort(Job->Run0Count, Job->Run0, Job->Out);
+	}
+	else
+	{
+		MergeSortedRuns(Job->Run0, Job->Run0Count, Job->Run1, Job->Run1Count, Job->Out);
+	}
+}
+
+void ParallelMergeSort(int Count, sort_entry* First, sort_entry* Temp, int ThreadCount)
+{
+	// NOTE(hugo) : One run per thread is sorted, then runs are merged two by two, each merge
+	// being a job of its own. Same result as MergeSort.
+	if((ThreadCount <= 1) || (Count < 4096))
+	{
+		MergeSort(Count, First, Temp);
+		return;
+	}
+	if(ThreadCount > MAX_THREAD_COUNT)
+	{
+		ThreadCount = MAX_THREAD_COUNT;
+	}
+
+	work_queue Queue = {};
+	sort_job Jobs[MAX_THREAD_COUNT];
+	int RunStarts[MAX_THREAD_COUNT + 1];
+	int RunCount = ThreadCount;
+	for(int RunIndex = 0; RunIndex <= RunCount; ++RunIndex)
+	{
+		RunStarts[RunIndex] = (int)(((int64_t)Count * RunIndex) / RunCount);
+	}
+
+	for(int RunIndex = 0; RunIndex < RunCount; ++RunIndex)
+	{
+		sort_job* Job = Jobs + RunIndex;
+		Job->Run0 = First + RunStarts[RunIndex];
+		Job->Run0Count = RunStarts[RunIndex + 1] - RunStarts[RunIndex];
+		Job->Run1Count = -1;
+		Job->Out = Temp + RunStarts[RunIndex];
+		AddWorkEntry(&Queue, DoSortJob, Job);
+	}
+	CompleteAllWork(&Queue, ThreadCount);
+
+	sort_entry* Source = First;
+	sort_entry* Dest = Temp;
+	while(RunCount > 1)
+	{
+		int MergedRunCount = 0;
+		for(int RunIndex = 0; RunIndex < RunCount; RunIndex += 2)
+		{
+			sort_job* Job = Jobs + MergedRunCount;
+			Job->Run0 = Source + RunStarts[RunIndex];
+			Job->Run0Count = RunStarts[RunIndex + 1] - RunStarts[RunIndex];
+			Job->Run1 = Source + RunStarts[RunIndex + 1];
+			Job->Run1Count = 0;
+			if(RunIndex + 1 < RunCount)
+			{
+				Job->Run1Count = RunStarts[RunIndex + 2] - RunStarts[RunIndex + 1];
+			}
+			Job->Out = Dest + RunStarts[RunIndex];
+			AddWorkEntry(&Queue, DoSortJob, Job);
+
+			RunStarts[MergedRunCount] = RunStarts[RunIndex];
+			MergedRunCount++;
+		}
+		RunStarts[MergedRunCount] = Count;
+		CompleteAllWork(&Queue, ThreadCount);
+
+		RunCount = MergedRunCount;
+		sort_entry* Swap = Source;
+		Source = Dest;
+		Dest = Swap;
+	}
+
+	if(Source != First)
+	{
+		for(int Index = 0; Index < Count; ++Index)
+		{
+			First[Index] = Source[Index];
+		}
+	}
+}
@@ -0,0 +1,1094 @@
+/* ------------------------------
+ *      tetrahedralization
+ * ------------------------------ */
+
+/*
+ * NOTE(hugo) : 3D Delaunay by Bowyer-Watson insertion.
+ *   - vertex 0 is the vertex at infinity : every convex hull face is closed by an infinite tetrahedron,
+ *     so there is no super tetrahedron and nothing to clean up, the hull is always right
+ *   - every tetrahedron is positively oriented (Orient3D > 0), the infinite vertex counting as a point
+ *     beyond the hull face it closes. Neighbour i is across the face opposite to vertex i.
+ *   - the points are inserted along a 3D Hilbert curve and located by walking from the last tetrahedron
+ *     created, so each location is a few steps
+ *   - a point conflicts with a finite tetrahedron if it is strictly in its circumsphere, and with an
+ *     infinite one if it is strictly beyond its hull face (or on it and in conflict with the finite
+ *     tetrahedron behind it). The conflicting tetrahedra are removed and the cavity is filled by joining
+ *     its boundary faces to the new point.
+ *   - with several threads, one point out of TETRAHEDRALIZATION_SAMPLE_STRIDE is inserted first, then the
+ *     Hilbert order is cut in one chunk per thread. A thread try-locks every tetrahedron it reads (its walk,
+ *     its cavity and the tetrahedra around it) and only writes once it holds them all, otherwise it puts
+ *     the point aside. The points put aside are tried again, the last ones are inserted by a single thread.
+ *     For points in general position the result does not depend on the thread count, only the numbering
+ *     of the tetrahedra does. Cospherical points can end up split differently from one run to the next.
+ * Everything lives in one block given by the caller, see GetTetrahedralizationMemorySize.
+ */
+
+#define INFINITE_VERTEX_INDEX 0
+#define TETRAHEDRALIZATION_SCRATCH_SIZE (1 << 16)
+// NOTE(hugo) : Threads other than 0 only insert while the others do, a cavity that does not fit is put aside
+#define TETRAHEDRALIZATION_WORKER_SCRATCH_SIZE (1 << 12)
+#define TETRAHEDRALIZATION_SAMPLE_STRIDE 64
+#define TETRAHEDRALIZATION_PARALLEL_MIN_POINT_COUNT (1 << 14)
+#define TETRAHEDRALIZATION_RETRY_COUNT 3
+
+struct vertex3
+{
+	double Position[3];
+};
+
+struct tetrahedron
+{
+	// NOTE(hugo) : VertexIndices[0] == -1 for a deleted tetrahedron, then NeighbourIndices[0] links the free list
+	// and NeighbourIndices[1] is a live tetrahedron a walk starting there can go on from
+	int VertexIndices[4];
+	int NeighbourIndices[4];
+};
+
+struct cavity_face
+{
+	// NOTE(hugo) : The new tetrahedron on this boundary face, the tetrahedron on the other side
+	// and the index of the face in it
+	int VertexIndices[4];
+	int NewVertexSlot;
+	int NewTetrahedronIndex;
+	int OutsideTetrahedronIndex;
+	int OutsideFaceIndex;
+};
+
+struct cavity_edge_slot
+{
+	int Generation;
+	int Vertex0Index;
+	int Vertex1Index;
+	int TetrahedronIndex;
+	int FaceIndex;
+};
+
+enum insertion_status
+{
+	Insertion_Done,
+	Insertion_Duplicate,
+	// NOTE(hugo) : Another thread held a tetrahedron this insertion needed, or the cavity did not fit
+	// in the scratch. Nothing was changed.
+	Insertion_Deferred,
+};
+
+struct tetrahedralization_thread
+{
+	// NOTE(hugo) : Everything an insertion writes besides the tetrahedra. Thread 0 does the sequential
+	// insertions and has the larger scratch.
+	int ThreadIndex;
+	bool UsesLocks;
+	uint32_t RandomState;
+	int LastTetrahedronIndex;
+	int FirstFreeTetrahedronIndex;
+
+	int ScratchSize;
+	int* CavityTetrahedronIndices;
+	cavity_face* CavityFaces;
+	cavity_edge_slot* EdgeSlots;
+	int EdgeSlotGeneration;
+	int EdgeSlotBitCount;
+
+	// NOTE(hugo) : Up to 4 * ScratchSize
+	int* LockedTetrahedronIndices;
+	int LockedCount;
+
+	// NOTE(hugo) : For the exact in-sphere test, see ExactInSphere
+	double* InSphereScratch;
+};
+
+struct tetrahedralization
+{
+	// NOTE(hugo) : Tetrahedralize stores the points along the Hilbert curve, so that vertices close in space
+	// are close in memory. SourcePointIndices gives the input index of each vertex (-1 for the infinite one).
+	vertex3* Vertices;
+	int* SourcePointIndices;
+	int VertexCount;
+	int MaxVertexCount;
+
+	tetrahedron* Tetrahedra;
+	int TetrahedronCount;
+	int MaxTetrahedronCount;
+	// NOTE(hugo) : Stands for TetrahedronCount while the threads insert
+	SDL_atomic_t SharedTetrahedronCount;
+	// NOTE(hugo) : Per tetrahedron, 0 or 1 + the index of the thread holding it
+	SDL_atomic_t* TetrahedronLocks;
+
+	int DuplicateVertexCount;
+
+	// NOTE(hugo) : Per tetrahedron, 2 * v if it is in the cavity of vertex v, 2 * v + 1 if it was tested and is not
+	int* ConflictMarks;
+
+	tetrahedralization_thread* Threads;
+	int MaxThreadCount;
+
+	// NOTE(hugo) : The vertices each chunk has left to insert, stored in the chunk's own range
+	int* PendingVertexIndices;
+
+	sort_entry* SortEntries;
+	sort_entry* SortTemp;
+};
+
+int GetMaxTetrahedronCount(int MaxPointCount)
+{
+	// NOTE(hugo) : A Delaunay tetrahedralization of well spread points has about 6.7 tetrahedra
+	// per point, the infinite ones included. This does not hold for adversarial inputs (it can go
+	// quadratic), the arena then runs out and Asserts.
+	return(8 * MaxPointCount + 64);
+}
+
+size_t GetThreadScratchMemorySize(int ScratchSize)
+{
+	size_t Result = 0;
+	Result += ScratchSize * (sizeof(int) + sizeof(cavity_face) + 2 * sizeof(cavity_edge_slot) + 4 * sizeof(int));
+	Result += IN_SPHERE_SCRATCH_COUNT * sizeof(double);
+
+	return(Result);
+}
+
+size_t GetTetrahedralizationMemorySize(int MaxPointCount, int MaxThreadCount)
+{
+	Assert((MaxThreadCount >= 1) && (MaxThreadCount <= MAX_THREAD_COUNT));
+	size_t MaxTetrahedronCount = GetMaxTetrahedronCount(MaxPointCount);
+	size_t Result = 0;
+	Result += (MaxPointCount + 1) * (sizeof(vertex3) + 2 * sizeof(int));
+	Result += MaxTetrahedronCount * (sizeof(tetrahedron) + sizeof(int) + sizeof(SDL_atomic_t));
+	Result += 2 * MaxPointCount * sizeof(sort_entry);
+	Result += MaxThreadCount * sizeof(tetrahedralization_thread);
+	Result += GetThreadScratchMemorySize(TETRAHEDRALIZATION_SCRATCH_SIZE);
+	Result += (MaxThreadCount - 1) * GetThreadScratchMemorySize(TETRAHEDRALIZATION_WORKER_SCRATCH_SIZE);
+	// NOTE(hugo) : Alignment padding
+	Result += 16 * (16 + 8 * MaxThreadCount);
+
+	return(Result);
+}
+
+void InitTetrahedralization(tetrahedralization* T, void* Memory, size_t MemorySize, int MaxPointCount, int MaxThreadCount)
+{
+	// NOTE(hugo) : Tetrahedralize uses at most MaxThreadCount threads
+	Assert((MaxThreadCount >= 1) && (MaxThreadCount <= MAX_THREAD_COUNT));
+	memory_arena Arena = {};
+	Arena.Base = (uint8_t*)Memory;
+	Arena.Size = MemorySize;
+
+	*T = {};
+	T->MaxVertexCount = MaxPointCount + 1;
+	T->MaxTetrahedronCount = GetMaxTetrahedronCount(MaxPointCount);
+	T->Vertices = PushArray(&Arena, T->MaxVertexCount, vertex3);
+	T->SourcePointIndices = PushArray(&Arena, T->MaxVertexCount, int);
+	T->PendingVertexIndices = PushArray(&Arena, T->MaxVertexCount, int);
+	T->Tetrahedra = PushArray(&Arena, T->MaxTetrahedronCount, tetrahedron);
+	T->ConflictMarks = PushArray(&Arena, T->MaxTetrahedronCount, int);
+	T->TetrahedronLocks = PushArray(&Arena, T->MaxTetrahedronCount, SDL_atomic_t);
+	T->SortEntries = PushArray(&Arena, MaxPointCount, sort_entry);
+	T->SortTemp = PushArray(&Arena, MaxPointCount, sort_entry);
+	T->Threads = PushArray(&Arena, MaxThreadCount, tetrahedralization_thread);
+	T->MaxThreadCount = MaxThreadCount;
+	T->VertexCount = 1;
+	T->SourcePointIndices[INFINITE_VERTEX_INDEX] = -1;
+
+	for(int ThreadIndex = 0; ThreadIndex < MaxThreadCount; ++ThreadIndex)
+	{
+		tetrahedralization_thread* Thread = T->Threads + ThreadIndex;
+		*Thread = {};
+		Thread->ThreadIndex = ThreadIndex;
+		Thread->RandomState = 0x9E3779B9 + ThreadIndex;
+		Thread->FirstFreeTetrahedronIndex = -1;
+		Thread->ScratchSize = (ThreadIndex == 0) ? TETRAHEDRALIZATION_SCRATCH_SIZE : TETRAHEDRALIZATION_WORKER_SCRATCH_SIZE;
+		Thread->CavityTetrahedronIndices = PushArray(&Arena, Thread->ScratchSize, int);
+		Thread->CavityFaces = PushArray(&Arena, Thread->ScratchSize, cavity_face);
+		Thread->EdgeSlots = PushArray(&Arena, 2 * Thread->ScratchSize, cavity_edge_slot);
+		Thread->LockedTetrahedronIndices = PushArray(&Arena, 4 * Thread->ScratchSize, int);
+		Thread->InSphereScratch = PushArray(&Arena, IN_SPHERE_SCRATCH_COUNT, double);
+		for(int SlotIndex = 0; SlotIndex < 2 * Thread->ScratchSize; ++SlotIndex)
+		{
+			Thread->EdgeSlots[SlotIndex].Generation = 0;
+		}
+	}
+}
+
+inline bool IsFiniteTetrahedron(tetrahedralization* T, int TetrahedronIndex)
+{
+	int* VertexIndices = T->Tetrahedra[TetrahedronIndex].VertexIndices;
+	bool Result = ((VertexIndices[0] > 0) && (VertexIndices[1] > 0) && (VertexIndices[2] > 0) && (VertexIndices[3] > 0));
+
+	return(Result);
+}
+
+inline bool IsTetrahedronAlive(tetrahedralization* T, int TetrahedronIndex)
+{
+	return(T->Tetrahedra[TetrahedronIndex].VertexIndices[0] != -1);
+}
+
+int InfiniteVertexSlot(tetrahedron* Tetrahedron)
+{
+	for(int i = 0; i < 4; ++i)
+	{
+		if(Tetrahedron->VertexIndices[i] == INFINITE_VERTEX_INDEX)
+		{
+			return(i);
+		}
+	}
+
+	return(-1);
+}
+
+bool LockTetrahedron(tetrahedralization* T, tetrahedralization_thread* Thread, int TetrahedronIndex)
+{
+	// NOTE(hugo) : Try-lock, nobody ever waits for a tetrahedron so there is no deadlock. True if the
+	// thread already holds it, and always without locks.
+	if(!Thread->UsesLocks)
+	{
+		return(true);
+	}
+	SDL_atomic_t* Lock = T->TetrahedronLocks + TetrahedronIndex;
+	int Owner = Thread->ThreadIndex + 1;
+	if(SDL_AtomicGet(Lock) == Owner)
+	{
+		return(true);
+	}
+	if((Thread->LockedCount == 4 * Thread->ScratchSize) || !SDL_AtomicCAS(Lock, 0, Owner))
+	{
+		return(false);
+	}
+	Thread->LockedTetrahedronIndices[Thread->LockedCount++] = TetrahedronIndex;
+
+	return(true);
+}
+
+void UnlockTetrahedron(tetrahedralization* T, tetrahedralization_thread* Thread, int TetrahedronIndex)
+{
+	// NOTE(hugo) : SDL_AtomicSet only guarantees an acquire barrier with GCC, the writes made under
+	// the lock must be visible before it is released
+	bool Unlocked = SDL_AtomicCAS(T->TetrahedronLocks + TetrahedronIndex, Thread->ThreadIndex + 1, 0);
+	Assert(Unlocked);
+}
+
+void UnlockTetrahedra(tetrahedralization* T, tetrahedralization_thread* Thread)
+{
+	for(int LockedIndex = 0; LockedIndex < Thread->LockedCount; ++LockedIndex)
+	{
+		UnlockTetrahedron(T, Thread, Thread->LockedTetrahedronIndices[LockedIndex]);
+	}
+	Thread->LockedCount = 0;
+}
+
+int AllocateTetrahedron(tetrahedralization* T, tetrahedralization_thread* Thread)
+{
+	// NOTE(hugo) : A tetrahedron never used before, so nothing points to it and nobody else can lock it
+	int Result = Thread->UsesLocks ? SDL_AtomicAdd(&T->SharedTetrahedronCount, 1) : T->TetrahedronCount++;
+	Assert(Result < T->MaxTetrahedronCount);
+	T->ConflictMarks[Result] = -1;
+	if(Thread->UsesLocks)
+	{
+		Assert(Thread->LockedCount < 4 * Thread->ScratchSize);
+		SDL_AtomicSet(T->TetrahedronLocks + Result, Thread->ThreadIndex + 1);
+		Thread->LockedTetrahedronIndices[Thread->LockedCount++] = Result;
+	}
+	else
+	{
+		SDL_AtomicSet(T->TetrahedronLocks + Result, 0);
+	}
+
+	return(Result);
+}
+
+void DeleteTetrahedron(tetrahedralization* T, tetrahedralization_thread* Thread, int TetrahedronIndex, int ReplacementIndex)
+{
+	tetrahedron* Tetrahedron = T->Tetrahedra + TetrahedronIndex;
+	Tetrahedron->VertexIndices[0] = -1;
+	Tetrahedron->NeighbourIndices[0] = Thread->FirstFreeTetrahedronIndex;
+	Tetrahedron->NeighbourIndices[1] = ReplacementIndex;
+	Thread->FirstFreeTetrahedronIndex = TetrahedronIndex;
+}
+
+uint32_t NextRandom(tetrahedralization_thread* Thread)
+{
+	return(XorShift32(&Thread->RandomState));
+}
+
+int OrientWithVertexReplaced(tetrahedralization* T, tetrahedron* Tetrahedron, int Slot, double* P)
+{
+	// NOTE(hugo) : Orient3D of the tetrahedron where vertex Slot is replaced by P, i.e. is P on the
+	// same side of face Slot as that vertex ? The infinite vertex must not be one of the other three.
+	double* Points[4];
+	for(int i = 0; i < 4; ++i)
+	{
+		Points[i] = (i == Slot) ? P : T->Vertices[Tetrahedron->VertexIndices[i]].Position;
+	}
+
+	return(FilteredOrient3D(Points[0], Points[1], Points[2], Points[3]));
+}
+
+bool LockForConflictTest(tetrahedralization* T, tetrahedralization_thread* Thread, int TetrahedronIndex)
+{
+	// NOTE(hugo) : IsInConflict may read the finite tetrahedron behind an infinite one
+	if(!LockTetrahedron(T, Thread, TetrahedronIndex))
+	{
+		return(false);
+	}
+	tetrahedron* Tetrahedron = T->Tetrahedra + TetrahedronIndex;
+	int InfiniteSlot = InfiniteVertexSlot(Tetrahedron);
+
+	return((InfiniteSlot == -1) || LockTetrahedron(T, Thread, Tetrahedron->NeighbourIndices[InfiniteSlot]));
+}
+
+bool IsInConflict(tetrahedralization* T, tetrahedralization_thread* Thread, int TetrahedronIndex, double* P)
+{
+	tetrahedron* Tetrahedron = T->Tetrahedra + TetrahedronIndex;
+	int InfiniteSlot = InfiniteVertexSlot(Tetrahedron);
+	if(InfiniteSlot == -1)
+	{
+		double* Points[4];
+		for(int i = 0; i < 4; ++i)
+		{
+			Points[i] = T->Vertices[Tetrahedron->VertexIndices[i]].Position;
+		}
+		return(FilteredInSphere(Points[0], Points[1], Points[2], Points[3], P, Thread->InSphereScratch) > 0);
+	}
+
+	int Orientation = OrientWithVertexReplaced(T, Tetrahedron, InfiniteSlot, P);
+	if(Orientation != 0)
+	{
+		return(Orientation > 0);
+	}
+
+	// NOTE(hugo) : P is in the plane of the hull face. Any sphere through the face cuts that plane
+	// along the circumcircle of the face, so the finite tetrahedron behind it decides.
+	return(IsInConflict(T, Thread, Tetrahedron->NeighbourIndices[InfiniteSlot], P));
+}
+
+bool MoveWalkTo(tetrahedralization* T, tetrahedralization_thread* Thread, int* TetrahedronIndex, int NextTetrahedronIndex)
+{
+	// NOTE(hugo) : Only the tetrahedron the walk is on stays locked
+	if(!LockTetrahedron(T, Thread, NextTetrahedronIndex))
+	{
+		return(false);
+	}
+	if(Thread->UsesLocks)
+	{
+		UnlockTetrahedron(T, Thread, *TetrahedronIndex);
+		Thread->LockedTetrahedronIndices[0] = NextTetrahedronIndex;
+		Thread->LockedCount = 1;
+	}
+	*TetrahedronIndex = NextTetrahedronIndex;
+
+	return(true);
+}
+
+int LocatePoint(tetrahedralization* T, tetrahedralization_thread* Thread, double* P)
+{
+	// NOTE(hugo) : Visibility walk, the first face tested is random so the walk cannot cycle.
+	// Returns a finite tetrahedron containing P (maybe on its boundary) or an infinite one whose hull face P is beyond,
+	// locked. -1 if another thread holds a tetrahedron on the way.
+	int TetrahedronIndex = Thread->LastTetrahedronIndex;
+	if(!LockTetrahedron(T, Thread, TetrahedronIndex))
+	{
+		return(-1);
+	}
+	for(;;)
+	{
+		tetrahedron* Tetrahedron = T->Tetrahedra + TetrahedronIndex;
+		int NextTetrahedronIndex = -1;
+		if(!IsTetrahedronAlive(T, TetrahedronIndex))
+		{
+			// NOTE(hugo) : Deleted since this thread was last here
+			NextTetrahedronIndex = Tetrahedron->NeighbourIndices[1];
+		}
+		else
+		{
+			int InfiniteSlot = InfiniteVertexSlot(Tetrahedron);
+			if(InfiniteSlot != -1)
+			{
+				if(OrientWithVertexReplaced(T, Tetrahedron, InfiniteSlot, P) > 0)
+				{
+					return(TetrahedronIndex);
+				}
+				NextTetrahedronIndex = Tetrahedron->NeighbourIndices[InfiniteSlot];
+			}
+			else
+			{
+				int FirstSlot = NextRandom(Thread) & 3;
+				for(int k = 0; k < 4; ++k)
+				{
+					int Slot = (FirstSlot + k) & 3;
+					if(OrientWithVertexReplaced(T, Tetrahedron, Slot, P) < 0)
+					{
+						NextTetrahedronIndex = Tetrahedron->NeighbourIndices[Slot];
+						break;
+					}
+				}
+				if(NextTetrahedronIndex == -1)
+				{
+					return(TetrahedronIndex);
+				}
+			}
+		}
+
+		if(!MoveWalkTo(T, Thread, &TetrahedronIndex, NextTetrahedronIndex))
+		{
+			return(-1);
+		}
+	}
+}
+
+void LinkCavityEdge(tetrahedralization* T, tetrahedralization_thread* Thread, int Vertex0Index, int Vertex1Index, int TetrahedronIndex, int FaceIndex)
+{
+	// NOTE(hugo) : The new tetrahedra sharing the face (P, Vertex0, Vertex1) meet here, open addressing
+	// on the edge. Slots of an older insertion count as empty thanks to the generation.
+	if(Vertex0Index > Vertex1Index)
+	{
+		int Swap = Vertex0Index;
+		Vertex0Index = Vertex1Index;
+		Vertex1Index = Swap;
+	}
+	uint32_t Mask = (1u << Thread->EdgeSlotBitCount) - 1;
+	uint32_t Hash = ((uint32_t)Vertex0Index * 0x9E3779B1u) ^ ((uint32_t)Vertex1Index * 0x85EBCA77u);
+	uint32_t SlotIndex = (Hash * 0xC2B2AE3Du) >> (32 - Thread->EdgeSlotBitCount);
+	for(;;)
+	{
+		cavity_edge_slot* Slot = Thread->EdgeSlots + SlotIndex;
+		if(Slot->Generation != Thread->EdgeSlotGeneration)
+		{
+			Slot->Generation = Thread->EdgeSlotGeneration;
+			Slot->Vertex0Index = Vertex0Index;
+			Slot->Vertex1Index = Vertex1Index;
+			Slot->TetrahedronIndex = TetrahedronIndex;
+			Slot->FaceIndex = FaceIndex;
+			return;
+		}
+		if((Slot->Vertex0Index == Vertex0Index) && (Slot->Vertex1Index == Vertex1Index))
+		{
+			T->Tetrahedra[TetrahedronIndex].NeighbourIndices[FaceIndex] = Slot->TetrahedronIndex;
+			T->Tetrahedra[Slot->TetrahedronIndex].NeighbourIndices[Slot->FaceIndex] = TetrahedronIndex;
+			return;
+		}
+		SlotIndex = (SlotIndex + 1) & Mask;
+	}
+}
+
+insertion_status DeferInsertion(tetrahedralization* T, tetrahedralization_thread* Thread, int VertexIndex)
+{
+	// NOTE(hugo) : Nothing was written but the marks, which must not be taken for a later attempt's
+	Assert(Thread->UsesLocks);
+	for(int LockedIndex = 0; LockedIndex < Thread->LockedCount; ++LockedIndex)
+	{
+		int TetrahedronIndex = Thread->LockedTetrahedronIndices[LockedIndex];
+		if((T->ConflictMarks[TetrahedronIndex] >> 1) == VertexIndex)
+		{
+			T->ConflictMarks[TetrahedronIndex] = -1;
+		}
+	}
+	UnlockTetrahedra(T, Thread);
+
+	return(Insertion_Deferred);
+}
+
+insertion_status InsertStoredVertex3(tetrahedralization* T, tetrahedralization_thread* Thread, int VertexIndex)
+{
+	// NOTE(hugo) : The position is already in T->Vertices. Nothing is inserted for a duplicate, nor when the
+	// thread could not hold every tetrahedron it needs (Insertion_Deferred, only with locks).
+	double* P = T->Vertices[VertexIndex].Position;
+	int LocatedIndex = LocatePoint(T, Thread, P);
+	if(LocatedIndex == -1)
+	{
+		return(DeferInsertion(T, Thread, VertexIndex));
+	}
+	if(IsFiniteTetrahedron(T, LocatedIndex))
+	{
+		for(int i = 0; i < 4; ++i)
+		{
+			double* Q = T->Vertices[T->Tetrahedra[LocatedIndex].VertexIndices[i]].Position;
+			if((Q[0] == P[0]) && (Q[1] == P[1]) && (Q[2] == P[2]))
+			{
+				UnlockTetrahedra(T, Thread);
+				return(Insertion_Duplicate);
+			}
+		}
+	}
+
+	// NOTE(hugo) : Cavity, grown from the located tetrahedron which is always in conflict
+	int CavityCount = 0;
+	int FaceCount = 0;
+	Thread->CavityTetrahedronIndices[CavityCount++] = LocatedIndex;
+	T->ConflictMarks[LocatedIndex] = 2 * VertexIndex;
+	for(int CavityIndex = 0; CavityIndex < CavityCount; ++CavityIndex)
+	{
+		int TetrahedronIndex = Thread->CavityTetrahedronIndices[CavityIndex];
+		for(int Slot = 0; Slot < 4; ++Slot)
+		{
+			int NeighbourIndex = T->Tetrahedra[TetrahedronIndex].NeighbourIndices[Slot];
+			if(!LockForConflictTest(T, Thread, NeighbourIndex))
+			{
+				return(DeferInsertion(T, Thread, VertexIndex));
+			}
+			if((T->ConflictMarks[NeighbourIndex] >> 1) != VertexIndex)
+			{
+				bool Conflict = IsInConflict(T, Thread, NeighbourIndex, P);
+				T->ConflictMarks[NeighbourIndex] = 2 * VertexIndex + (Conflict ? 0 : 1);
+				if(Conflict)
+				{
+					if(CavityCount == Thread->ScratchSize)
+					{
+						return(DeferInsertion(T, Thread, VertexIndex));
+					}
+					Thread->CavityTetrahedronIndices[CavityCount++] = NeighbourIndex;
+				}
+			}
+
+			if(T->ConflictMarks[NeighbourIndex] == 2 * VertexIndex + 1)
+			{
+				// NOTE(hugo) : Boundary face, P replaces the vertex facing it
+				if(FaceCount == Thread->ScratchSize)
+				{
+					return(DeferInsertion(T, Thread, VertexIndex));
+				}
+				cavity_face* Face = Thread->CavityFaces + FaceCount++;
+				tetrahedron* Neighbour = T->Tetrahedra + NeighbourIndex;
+				for(int i = 0; i < 4; ++i)
+				{
+					Face->VertexIndices[i] = T->Tetrahedra[TetrahedronIndex].VertexIndices[i];
+					if(Neighbour->NeighbourIndices[i] == TetrahedronIndex)
+					{
+						Face->OutsideFaceIndex = i;
+					}
+				}
+				Face->VertexIndices[Slot] = VertexIndex;
+				Face->NewVertexSlot = Slot;
+				Face->OutsideTetrahedronIndex = NeighbourIndex;
+			}
+		}
+	}
+
+	// NOTE(hugo) : One new tetrahedron per boundary face. They take the place of the cavity ones, then of
+	// the free ones of this thread, then of never used ones. This is the last place to give up, nothing
+	// has been written yet.
+	if((4 * FaceCount > 2 * Thread->ScratchSize) || (Thread->UsesLocks && (Thread->LockedCount + FaceCount > 4 * Thread->ScratchSize)))
+	{
+		return(DeferInsertion(T, Thread, VertexIndex));
+	}
+	int FreeIndex = Thread->FirstFreeTetrahedronIndex;
+	for(int FaceIndex = 0; FaceIndex < FaceCount; ++FaceIndex)
+	{
+		cavity_face* Face = Thread->CavityFaces + FaceIndex;
+		Face->NewTetrahedronIndex = -1;
+		if(FaceIndex < CavityCount)
+		{
+			Face->NewTetrahedronIndex = Thread->CavityTetrahedronIndices[FaceIndex];
+		}
+		else if(FreeIndex != -1)
+		{
+			if(!LockTetrahedron(T, Thread, FreeIndex))
+			{
+				return(DeferInsertion(T, Thread, VertexIndex));
+			}
+			Face->NewTetrahedronIndex = FreeIndex;
+			FreeIndex = T->Tetrahedra[FreeIndex].NeighbourIndices[0];
+		}
+	}
+	Thread->FirstFreeTetrahedronIndex = FreeIndex;
+	for(int CavityIndex = FaceCount; CavityIndex < CavityCount; ++CavityIndex)
+	{
+		DeleteTetrahedron(T, Thread, Thread->CavityTetrahedronIndices[CavityIndex], Thread->CavityFaces[0].NewTetrahedronIndex);
+	}
+
+	// NOTE(hugo) : Each new tetrahedron is glued to the outside through its boundary face and to the other
+	// new ones through the faces containing P. Only as many edge slots as needed are used, so that they stay in cache.
+	Thread->EdgeSlotGeneration++;
+	Thread->EdgeSlotBitCount = 6;
+	while((1 << Thread->EdgeSlotBitCount) < 4 * FaceCount)
+	{
+		Thread->EdgeSlotBitCount++;
+	}
+	Assert((1 << Thread->EdgeSlotBitCount) <= 2 * Thread->ScratchSize);
+	for(int FaceIndex = 0; FaceIndex < FaceCount; ++FaceIndex)
+	{
+		cavity_face* Face = Thread->CavityFaces + FaceIndex;
+		int NewIndex = Face->NewTetrahedronIndex;
+		if(NewIndex == -1)
+		{
+			NewIndex = AllocateTetrahedron(T, Thread);
+		}
+		tetrahedron* New = T->Tetrahedra + NewIndex;
+		for(int i = 0; i < 4; ++i)
+		{
+			New->VertexIndices[i] = Face->VertexIndices[i];
+		}
+		New->NeighbourIndices[Face->NewVertexSlot] = Face->OutsideTetrahedronIndex;
+		T->Tetrahedra[Face->OutsideTetrahedronIndex].NeighbourIndices[Face->OutsideFaceIndex] = NewIndex;
+
+		for(int Slot = 0; Slot < 4; ++Slot)
+		{
+			if(Slot != Face->NewVertexSlot)
+			{
+				int Others[2];
+				int OtherCount = 0;
+				for(int i = 0; i < 4; ++i)
+				{
+					if((i != Slot) && (i != Face->NewVertexSlot))
+					{
+						Others[OtherCount++] = New->VertexIndices[i];
+					}
+				}
+				LinkCavityEdge(T, Thread, Others[0], Others[1], NewIndex, Slot);
+			}
+		}
+		Thread->LastTetrahedronIndex = NewIndex;
+	}
+	UnlockTetrahedra(T, Thread);
+
+	return(Insertion_Done);
+}
+
+int InsertVertex3(tetrahedralization* T, double* P)
+{
+	// NOTE(hugo) : Returns the new vertex index, or -1 if P is already a vertex. It has no source point index.
+	Assert(T->VertexCount < T->MaxVertexCount);
+	int VertexIndex = T->VertexCount++;
+	for(int Axis = 0; Axis < 3; ++Axis)
+	{
+		T->Vertices[VertexIndex].Position[Axis] = P[Axis];
+	}
+	T->SourcePointIndices[VertexIndex] = -1;
+	if(InsertStoredVertex3(T, T->Threads, VertexIndex) == Insertion_Duplicate)
+	{
+		T->DuplicateVertexCount++;
+		T->VertexCount--;
+		return(-1);
+	}
+
+	return(VertexIndex);
+}
+
+struct tetrahedralization_job
+{
+	tetrahedralization* T;
+	int StartTetrahedronIndex;
+	int* PendingVertexIndices;
+	int PendingCount;
+	int DuplicateVertexCount;
+};
+
+void DoTetrahedralizationJob(int ThreadIndex, void* Data)
+{
+	// NOTE(hugo) : Inserts the pending vertices of a chunk, those put aside stay pending
+	tetrahedralization_job* Job = (tetrahedralization_job*)Data;
+	tetrahedralization* T = Job->T;
+	Assert(ThreadIndex < T->MaxThreadCount);
+	tetrahedralization_thread* Thread = T->Threads + ThreadIndex;
+	Thread->UsesLocks = true;
+	Thread->LastTetrahedronIndex = Job->StartTetrahedronIndex;
+
+	int KeptCount = 0;
+	for(int PendingIndex = 0; PendingIndex < Job->PendingCount; ++PendingIndex)
+	{
+		int VertexIndex = Job->PendingVertexIndices[PendingIndex];
+		insertion_status Status = InsertStoredVertex3(T, Thread, VertexIndex);
+		if(Status == Insertion_Deferred)
+		{
+			Job->PendingVertexIndices[KeptCount++] = VertexIndex;
+		}
+		Job->DuplicateVertexCount += (Status == Insertion_Duplicate);
+	}
+	Job->PendingCount = KeptCount;
+	Job->StartTetrahedronIndex = Thread->LastTetrahedronIndex;
+	Thread->UsesLocks = false;
+}
+
+void HilbertAxesToTranspose(uint32_t* X, int BitCount)
+{
+	// NOTE(hugo) : Skilling's transform, the Hilbert index is then the bits of X[0], X[1], X[2] interleaved
+	uint32_t M = 1u << (BitCount - 1);
+	for(uint32_t Q = M; Q > 1; Q >>= 1)
+	{
+		uint32_t P = Q - 1;
+		for(int i = 0; i < 3; ++i)
+		{
+			if(X[i] & Q)
+			{
+				X[0] ^= P;
+			}
+			else
+			{
+				uint32_t t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	for(int i = 1; i < 3; ++i)
+	{
+		X[i] ^= X[i - 1];
+	}
+	uint32_t t = 0;
+	for(uint32_t Q = M; Q > 1; Q >>= 1)
+	{
+		if(X[2] & Q)
+		{
+			t ^= Q - 1;
+		}
+	}
+	for(int i = 0; i < 3; ++i)
+	{
+		X[i] ^= t;
+	}
+}
+
+uint64_t HilbertIndex3(uint32_t x, uint32_t y, uint32_t z)
+{
+	// NOTE(hugo) : Position of (x, y, z) along the Hilbert curve filling a 2^21 x 2^21 x 2^21 grid
+	uint32_t X[3] = {x, y, z};
+	HilbertAxesToTranspose(X, 21);
+	uint64_t Result = 0;
+	for(int Bit = 20; Bit >= 0; --Bit)
+	{
+		for(int i = 0; i < 3; ++i)
+		{
+			Result = (Result << 1) | ((X[i] >> Bit) & 1);
+		}
+	}
+
+	return(Result);
+}
+
+bool Tetrahedralize(tetrahedralization* T, int PointCount, double* Positions, int ThreadCount)
+{
+	// NOTE(hugo) : Positions holds x, y, z per point, see SourcePointIndices for the numbering (duplicates
+	// are stored but left out of the mesh). False if the points are all coplanar, there is no tetrahedron at all then.
+	// More points can be added afterwards with InsertVertex3. Uses at most the MaxThreadCount given to
+	// InitTetrahedralization, and a single thread below TETRAHEDRALIZATION_PARALLEL_MIN_POINT_COUNT points.
+	Assert(PointCount + 1 <= T->MaxVertexCount);
+	T->VertexCount = 1;
+	T->TetrahedronCount = 0;
+	T->DuplicateVertexCount = 0;
+	for(int ThreadIndex = 0; ThreadIndex < T->MaxThreadCount; ++ThreadIndex)
+	{
+		T->Threads[ThreadIndex].FirstFreeTetrahedronIndex = -1;
+	}
+	if(ThreadCount > T->MaxThreadCount)
+	{
+		ThreadCount = T->MaxThreadCount;
+	}
+
+	double Min[3];
+	double Max[3];
+	for(int Axis = 0; Axis < 3; ++Axis)
+	{
+		Min[Axis] = Max[Axis] = (PointCount > 0) ? Positions[Axis] : 0.0;
+	}
+	for(int PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+	{
+		for(int Axis = 0; Axis < 3; ++Axis)
+		{
+			double Value = Positions[3 * PointIndex + Axis];
+			Assert(isfinite(Value));
+			Min[Axis] = (Value < Min[Axis]) ? Value : Min[Axis];
+			Max[Axis] = (Value > Max[Axis]) ? Value : Max[Axis];
+		}
+	}
+	double Extent = 0.0;
+	for(int Axis = 0; Axis < 3; ++Axis)
+	{
+		Extent = ((Max[Axis] - Min[Axis]) > Extent) ? (Max[Axis] - Min[Axis]) : Extent;
+	}
+	double Scale = (Extent > 0.0) ? (2097151.0 / Extent) : 0.0;
+
+	for(int PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+	{
+		double* P = Positions + 3 * PointIndex;
+		sort_entry* Entry = T->SortEntries + PointIndex;
+		Entry->SortKey = HilbertIndex3((uint32_t)((P[0] - Min[0]) * Scale), (uint32_t)((P[1] - Min[1]) * Scale), (uint32_t)((P[2] - Min[2]) * Scale));
+		Entry->Index = PointIndex;
+	}
+	ParallelMergeSort(PointCount, T->SortEntries, T->SortTemp, ThreadCount);
+
+	// NOTE(hugo) : The first tetrahedron is made of the first four affinely independent points in that order
+	int FirstSortIndices[4] = {0, -1, -1, -1};
+	if(PointCount == 0)
+	{
+		return(false);
+	}
+	double* A = Positions + 3 * T->SortEntries[0].Index;
+	for(int SortIndex = 1; SortIndex < PointCount; ++SortIndex)
+	{
+		double* P = Positions + 3 * T->SortEntries[SortIndex].Index;
+		if(FirstSortIndices[1] == -1)
+		{
+			if((P[0] != A[0]) || (P[1] != A[1]) || (P[2] != A[2]))
+			{
+				FirstSortIndices[1] = SortIndex;
+			}
+		}
+		else if(FirstSortIndices[2] == -1)
+		{
+			// NOTE(hugo) : Aligned iff the three coordinate projections are
+			double* B = Positions + 3 * T->SortEntries[FirstSortIndices[1]].Index;
+			if((FilteredOrient2D(A[0], A[1], B[0], B[1], P[0], P[1]) != 0)
+					|| (FilteredOrient2D(A[1], A[2], B[1], B[2], P[1], P[2]) != 0)
+					|| (FilteredOrient2D(A[2], A[0], B[2], B[0], P[2], P[0]) != 0))
+			{
+				FirstSortIndices[2] = SortIndex;
+			}
+		}
+		else
+		{
+			double* B = Positions + 3 * T->SortEntries[FirstSortIndices[1]].Index;
+			double* C = Positions + 3 * T->SortEntries[FirstSortIndices[2]].Index;
+			if(FilteredOrient3D(A, B, C, P) != 0)
+			{
+				FirstSortIndices[3] = SortIndex;
+				break;
+			}
+		}
+	}
+	if(FirstSortIndices[3] == -1)
+	{
+		return(false);
+	}
+
+	for(int SortIndex = 0; SortIndex < PointCount; ++SortIndex)
+	{
+		int PointIndex = T->SortEntries[SortIndex].Index;
+		for(int Axis = 0; Axis < 3; ++Axis)
+		{
+			T->Vertices[SortIndex + 1].Position[Axis] = Positions[3 * PointIndex + Axis];
+		}
+		T->SourcePointIndices[SortIndex + 1] = PointIndex;
+	}
+	T->VertexCount = PointCount + 1;
+
+	int FirstVertexIndices[4];
+	for(int i = 0; i < 4; ++i)
+	{
+		FirstVertexIndices[i] = FirstSortIndices[i] + 1;
+	}
+	if(FilteredOrient3D(T->Vertices[FirstVertexIndices[0]].Position, T->Vertices[FirstVertexIndices[1]].Position,
+				T->Vertices[FirstVertexIndices[2]].Position, T->Vertices[FirstVertexIndices[3]].Position) < 0)
+	{
+		int Swap = FirstVertexIndices[0];
+		FirstVertexIndices[0] = FirstVertexIndices[1];
+		FirstVertexIndices[1] = Swap;
+	}
+
+	// NOTE(hugo) : Tetrahedron 0 is the finite one, tetrahedron i + 1 closes its face i. The infinite vertex
+	// takes the place of vertex i, which is on the wrong side of face i, so two others are swapped.
+	tetrahedralization_thread* MainThread = T->Threads;
+	int FiniteIndex = AllocateTetrahedron(T, MainThread);
+	for(int i = 0; i < 4; ++i)
+	{
+		T->Tetrahedra[FiniteIndex].VertexIndices[i] = FirstVertexIndices[i];
+		T->Tetrahedra[FiniteIndex].NeighbourIndices[i] = i + 1;
+	}
+	for(int i = 0; i < 4; ++i)
+	{
+		int InfiniteIndex = AllocateTetrahedron(T, MainThread);
+		tetrahedron* Infinite = T->Tetrahedra + InfiniteIndex;
+		for(int j = 0; j < 4; ++j)
+		{
+			Infinite->VertexIndices[j] = (j == i) ? INFINITE_VERTEX_INDEX : FirstVertexIndices[j];
+		}
+		int Swap0 = (i + 1) & 3;
+		int Swap1 = (i + 2) & 3;
+		int Swap = Infinite->VertexIndices[Swap0];
+		Infinite->VertexIndices[Swap0] = Infinite->VertexIndices[Swap1];
+		Infinite->VertexIndices[Swap1] = Swap;
+
+		// NOTE(hugo) : Face j of an infinite tetrahedron is shared with the infinite tetrahedron closing face j
+		// of the finite one (the two slots swapped above are exchanged for that too)
+		for(int j = 0; j < 4; ++j)
+		{
+			int FaceOf = (j == Swap0) ? Swap1 : ((j == Swap1) ? Swap0 : j);
+			Infinite->NeighbourIndices[j] = (j == i) ? FiniteIndex : (FaceOf + 1);
+		}
+	}
+	MainThread->LastTetrahedronIndex = FiniteIndex;
+
+	// NOTE(hugo) : With a single thread every point goes in now. Otherwise only the sample does, the other
+	// points are left pending in the chunk they fall in, and each chunk starts its walk where its first
+	// sample point went.
+	int SampleStride = 1;
+	int JobCount = 0;
+	tetrahedralization_job Jobs[MAX_THREAD_COUNT];
+	int JobFirstSortIndices[MAX_THREAD_COUNT + 1];
+	if((ThreadCount > 1) && (PointCount >= TETRAHEDRALIZATION_PARALLEL_MIN_POINT_COUNT))
+	{
+		SampleStride = TETRAHEDRALIZATION_SAMPLE_STRIDE;
+		JobCount = ThreadCount;
+		for(int JobIndex = 0; JobIndex <= JobCount; ++JobIndex)
+		{
+			JobFirstSortIndices[JobIndex] = (int)(((int64_t)PointCount * JobIndex) / JobCount);
+		}
+		for(int JobIndex = 0; JobIndex < JobCount; ++JobIndex)
+		{
+			tetrahedralization_job* Job = Jobs + JobIndex;
+			Job->T = T;
+			Job->StartTetrahedronIndex = -1;
+			Job->PendingVertexIndices = T->PendingVertexIndices + JobFirstSortIndices[JobIndex];
+			Job->PendingCount = 0;
+			Job->DuplicateVertexCount = 0;
+		}
+	}
+
+	int CurrentJobIndex = 0;
+	for(int SortIndex = 0; SortIndex < PointCount; ++SortIndex)
+	{
+		bool IsFirst = false;
+		for(int i = 0; i < 4; ++i)
+		{
+			IsFirst = IsFirst || (SortIndex == FirstSortIndices[i]);
+		}
+		if(IsFirst)
+		{
+			continue;
+		}
+		int VertexIndex = SortIndex + 1;
+		while((CurrentJobIndex + 1 < JobCount) && (SortIndex >= JobFirstSortIndices[CurrentJobIndex + 1]))
+		{
+			CurrentJobIndex++;
+		}
+		if((SortIndex % SampleStride) != 0)
+		{
+			tetrahedralization_job* Job = Jobs + CurrentJobIndex;
+			Job->PendingVertexIndices[Job->PendingCount++] = VertexIndex;
+			continue;
+		}
+
+		T->DuplicateVertexCount += (InsertStoredVertex3(T, MainThread, VertexIndex) == Insertion_Duplicate);
+		if((JobCount > 0) && (Jobs[CurrentJobIndex].StartTetrahedronIndex == -1))
+		{
+			Jobs[CurrentJobIndex].StartTetrahedronIndex = MainThread->LastTetrahedronIndex;
+		}
+	}
+
+	if(JobCount > 0)
+	{
+		SDL_AtomicSet(&T->SharedTetrahedronCount, T->TetrahedronCount);
+		work_queue Queue = {};
+		for(int Pass = 0; Pass <= TETRAHEDRALIZATION_RETRY_COUNT; ++Pass)
+		{
+			for(int JobIndex = 0; JobIndex < JobCount; ++JobIndex)
+			{
+				tetrahedralization_job* Job = Jobs + JobIndex;
+				if(Job->StartTetrahedronIndex == -1)
+				{
+					Job->StartTetrahedronIndex = FiniteIndex;
+				}
+				if(Job->PendingCount > 0)
+				{
+					AddWorkEntry(&Queue, DoTetrahedralizationJob, Job);
+				}
+			}
+			if(Queue.EntryCount == 0)
+			{
+				break;
+			}
+			CompleteAllWork(&Queue, ThreadCount);
+		}
+		T->TetrahedronCount = SDL_AtomicGet(&T->SharedTetrahedronCount);
+
+		// NOTE(hugo) : What is still pending goes in alone, and the free tetrahedra of every thread go
+		// to thread 0, the one InsertVertex3 uses
+		for(int JobIndex = 0; JobIndex < JobCount; ++JobIndex)
+		{
+			tetrahedralization_job* Job = Jobs + JobIndex;
+			for(int PendingIndex = 0; PendingIndex < Job->PendingCount; ++PendingIndex)
+			{
+				T->DuplicateVertexCount += (InsertStoredVertex3(T, MainThread, Job->PendingVertexIndices[PendingIndex]) == Insertion_Duplicate);
+			}
+			T->DuplicateVertexCount += Job->DuplicateVertexCount;
+		}
+		for(int ThreadIndex = 1; ThreadIndex < T->MaxThreadCount; ++ThreadIndex)
+		{
+			tetrahedralization_thread* Thread = T->Threads + ThreadIndex;
+			int FreeIndex = Thread->FirstFreeTetrahedronIndex;
+			while(FreeIndex != -1)
+			{
+				int NextFreeIndex = T->Tetrahedra[FreeIndex].NeighbourIndices[0];
+				T->Tetrahedra[FreeIndex].NeighbourIndices[0] = MainThread->FirstFreeTetrahedronIndex;
+				MainThread->FirstFreeTetrahedronIndex = FreeIndex;
+				FreeIndex = NextFreeIndex;
+			}
+			Thread->FirstFreeTetrahedronIndex = -1;
+		}
+	}
+
+	return(true);
+}
+
+bool IsTetrahedralizationValid(tetrahedralization* T)
+{
+	// NOTE(hugo) : Orientation, adjacency, and the local Delaunay / local convexity condition on every
+	// face, which together make the tetrahedralization Delaunay with the right hull. Slow, for debugging.
+	for(int TetrahedronIndex = 0; TetrahedronIndex < T->TetrahedronCount; ++TetrahedronIndex)
+	{
+		if(!IsTetrahedronAlive(T, TetrahedronIndex))
+		{
+			continue;
+		}
+		tetrahedron* Tetrahedron = T->Tetrahedra + TetrahedronIndex;
+		int InfiniteSlot = InfiniteVertexSlot(Tetrahedron);
+		if((InfiniteSlot == -1) && (OrientWithVertexReplaced(T, Tetrahedron, 0, T->Vertices[Tetrahedron->VertexIndices[0]].Position) <= 0))
+		{
+			return(false);
+		}
+
+		for(int Slot = 0; Slot < 4; ++Slot)
+		{
+			int NeighbourIndex = Tetrahedron->NeighbourIndices[Slot];
+			if((NeighbourIndex < 0) || (NeighbourIndex >= T->TetrahedronCount) || !IsTetrahedronAlive(T, NeighbourIndex))
+			{
+				return(false);
+			}
+
+			// NOTE(hugo) : The neighbour points back and has the three vertices of the face, the fourth one is Opposite
+			tetrahedron* Neighbour = T->Tetrahedra + NeighbourIndex;
+			int BackSlot = -1;
+			int SharedCount = 0;
+			int OppositeIndex = -1;
+			for(int i = 0; i < 4; ++i)
+			{
+				if(Neighbour->NeighbourIndices[i] == TetrahedronIndex)
+				{
+					BackSlot = i;
+				}
+				bool IsShared = false;
+				for(int j = 0; j < 4; ++j)
+				{
+					IsShared = IsShared || ((j != Slot) && (Tetrahedron->VertexIndices[j] == Neighbour->VertexIndices[i]));
+				}
+				SharedCount += IsShared;
+				OppositeIndex = IsShared ? OppositeIndex : Neighbour->VertexIndices[i];
+			}
+			if((BackSlot == -1) || (SharedCount != 3) || (Neighbour->VertexIndices[BackSlot] != OppositeIndex))
+			{
+				return(false);
+			}
+
+			if(OppositeIndex == INFINITE_VERTEX_INDEX)
+			{
+				continue;
+			}
+			if(InfiniteSlot == -1)
+			{
+				double* Points[4];
+				for(int i = 0; i < 4; ++i)
+				{
+					Points[i] = T->Vertices[Tetrahedron->VertexIndices[i]].Position;
+				}
+				if(FilteredInSphere(Points[0], Points[1], Points[2], Points[3], T->Vertices[OppositeIndex].Position, T->Threads->InSphereScratch) > 0)
+				{
+					return(false);
+				}
+			}
+			else if((Slot != InfiniteSlot) && (OrientWithVertexReplaced(T, Tetrahedron, InfiniteSlot, T->Vertices[OppositeIndex].Position) > 0))
+			{
+				// NOTE(hugo) : A vertex beyond the hull face next to this one, the hull is not convex
+				return(false);
+			}
+		}
+	}
+
+	return(true);
+}
@@ -1,10 +1,22 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <emmintrin.h>
+
+#include "delone_platform.h"
 
-#define ArrayCount(x) (sizeof((x))/(sizeof((x)[0])))
-#define Assert(x) do{if(!(x)){*(int*)0=0;}}while(0)
 #define MAX_POINT_COUNT 1000
 
+// NOTE(hugo) : DELONE_SLOW enables the checks that cost more than the operation they check, only the debug build sets it
+#if !defined(DELONE_SLOW)
+#define DELONE_SLOW 0
+#endif
+
+#include "delone_kernel.h"
+
 /*
  * TODO(hugo)
  *   - make the program robust 
@@ -20,87 +32,35 @@ static bool Running = true;
 static int ScreenWidth = 600;
 static int ScreenHeight = 600;
 
-/* ------------------------------
- *           mat4 
- * ------------------------------ */
-struct mat4
-{
-    float Data_[16];
-};
-
-inline float GetValue(mat4 M, int i, int j)
-{
-    Assert(i >= 0);
-    Assert(j >= 0);
-    Assert(i < 4);
-    Assert(j < 4);
-    return(M.Data_[4 * j + i]);
-}
-
-inline void SetValue(mat4* M, int i, int j, float Value)
-{
-    Assert(i >= 0);
-    Assert(j >= 0);
-    Assert(i < 4);
-    Assert(j < 4);
-    M->Data_[4 * j + i] = Value;
-}
-
-float Det(mat4 M)
-{
-	float Result = 0.0f;
-
-	Result += GetValue(M, 0, 0) * GetValue(M, 1, 1) * GetValue(M, 2, 2) * GetValue(M, 3, 3);
-	Result += GetValue(M, 0, 0) * GetValue(M, 1, 2) * GetValue(M, 2, 3) * GetValue(M, 3, 1);
-	Result += GetValue(M, 0, 0) * GetValue(M, 1, 3) * GetValue(M, 2, 1) * GetValue(M, 3, 2);
-
-	Result += GetValue(M, 0, 1) * GetValue(M, 1, 0) * GetValue(M, 2, 3) * GetValue(M, 3, 2);
-	Result += GetValue(M, 0, 1) * GetValue(M, 1, 2) * GetValue(M, 2, 0) * GetValue(M, 3, 3);
-	Result += GetValue(M, 0, 1) * GetValue(M, 1, 3) * GetValue(M, 2, 2) * GetValue(M, 3, 0);
-
-	Result += GetValue(M, 0, 2) * GetValue(M, 1, 0) * GetValue(M, 2, 1) * GetValue(M, 3, 3);
-	Result += GetValue(M, 0, 2) * GetValue(M, 1, 1) * GetValue(M, 2, 3) * GetValue(M, 3, 0);
-	Result += GetValue(M, 0, 2) * GetValue(M, 1, 3) * GetValue(M, 2, 0) * GetValue(M, 3, 1);
-
-	Result += GetValue(M, 0, 3) * GetValue(M, 1, 0) * GetValue(M, 2, 2) * GetValue(M, 3, 1);
-	Result += GetValue(M, 0, 3) * GetValue(M, 1, 1) * GetValue(M, 2, 0) * GetValue(M, 3, 2);
-	Result += GetValue(M, 0, 3) * GetValue(M, 1, 2) * GetValue(M, 2, 1) * GetValue(M, 3, 0);
-
-	Result -= GetValue(M, 0, 0) * GetValue(M, 1, 1) * GetValue(M, 2, 3) * GetValue(M, 3, 2);
-	Result -= GetValue(M, 0, 0) * GetValue(M, 1, 2) * GetValue(M, 2, 1) * GetValue(M, 3, 3);
-	Result -= GetValue(M, 0, 0) * GetValue(M, 1, 3) * GetValue(M, 2, 2) * GetValue(M, 3, 1);
-	
-	Result -= GetValue(M, 0, 1) * GetValue(M, 1, 0) * GetValue(M, 2, 2) * GetValue(M, 3, 3);
-	Result -= GetValue(M, 0, 1) * GetValue(M, 1, 2) * GetValue(M, 2, 3) * GetValue(M, 3, 0);
-	Result -= GetValue(M, 0, 1) * GetValue(M, 1, 3) * GetValue(M, 2, 0) * GetValue(M, 3, 2);
-
-	Result -= GetValue(M, 0, 2) * GetValue(M, 1, 0) * GetValue(M, 2, 3) * GetValue(M, 3, 1);
-	Result -= GetValue(M, 0, 2) * GetValue(M, 1, 1) * GetValue(M, 2, 0) * GetValue(M, 3, 3);
-	Result -= GetValue(M, 0, 2) * GetValue(M, 1, 3) * GetValue(M, 2, 1) * GetValue(M, 3, 0);
-
-	Result -= GetValue(M, 0, 3) * GetValue(M, 1, 0) * GetValue(M, 2, 1) * GetValue(M, 3, 2);
-	Result -= GetValue(M, 0, 3) * GetValue(M, 1, 1) * GetValue(M, 2, 2) * GetValue(M, 3, 0);
-	Result -= GetValue(M, 0, 3) * GetValue(M, 1, 2) * GetValue(M, 2, 0) * GetValue(M, 3, 1);
-
-	return(Result);
-}
-
+// NOTE(hugo) : Screen coordinates are small integers, the int32 kernel is exact and the cheapest one
+typedef kernel_i32 screen_kernel;
 
 /* ------------------------------
  *        triangulation 
  * ------------------------------ */
 
+template<typename kernel>
 struct vertex
 {
-	int x;
-	int y;
+	typename kernel::coord x;
+	typename kernel::coord y;
 	bool IsRealPoint;
+	// NOTE(hugo) : A vertex of the symbolic super triangle, infinitely far away in the direction number x,
+	// see OrientationAtInfinity
+	bool IsAtInfinity;
 };
 
 struct edge
 {
 	int Vertex0Index;
 	int Vertex1Index;
+
+	// NOTE(hugo) : A constrained edge is a segment the user forced into the mesh. It is never flipped.
+	bool IsConstrained;
+
+	// NOTE(hugo) : The (at most two) triangles incident to this edge, -1 if there is none.
+	// This is maintained by PushTriangle, DeleteTriangle and PerformLawsonFlip.
+	int TriangleIndices[2];
 };
 
 struct triangle
@@ -128,20 +88,80 @@ struct triangle
 	};
 };
 
+template<typename kernel>
 struct triangulation
 {
-	vertex Vertices[MAX_POINT_COUNT];
+	// NOTE(hugo) : The arrays are sized from MaxVertexCount (the fake vertices included), either by
+	// AttachTriangulationStorage or by PushTriangulation
+	vertex<kernel>* Vertices;
 	int VertexCount;
+	int MaxVertexCount;
+	// NOTE(hugo) : One triangle incident to each vertex, kept up to date by PushTriangle, DeleteTriangle and
+	// PerformLawsonFlip. It is only stale between the deletion and the re-creation of the triangles of a cavity.
+	int* VertexTriangleIndices;
 
-	edge Edges[MAX_POINT_COUNT];
+	// NOTE(hugo) : A triangulation of n points has less than 3n edges and 2n triangles
+	edge* Edges;
 	int EdgeCount;
 
-	triangle Triangles[MAX_POINT_COUNT];
+	triangle* Triangles;
 	int TriangleCount;
+
+	// NOTE(hugo) : The edges InsertVertex still has to check, 3 * MaxVertexCount
+	int* EdgeStack;
+};
+
+template<typename kernel>
+struct triangulation_storage
+{
+	// NOTE(hugo) : Room for MAX_POINT_COUNT vertices, for the triangulations kept in a struct or a static
+	vertex<kernel> Vertices[MAX_POINT_COUNT];
+	int VertexTriangleIndices[MAX_POINT_COUNT];
+	edge Edges[3 * MAX_POINT_COUNT];
+	triangle Triangles[2 * MAX_POINT_COUNT];
+	int EdgeStack[3 * MAX_POINT_COUNT];
 };
 
+template<typename kernel>
+void AttachTriangulationStorage(triangulation<kernel>* T, triangulation_storage<kernel>* Storage)
+{
+	*T = {};
+	T->MaxVertexCount = MAX_POINT_COUNT;
+	T->Vertices = Storage->Vertices;
+	T->VertexTriangleIndices = Storage->VertexTriangleIndices;
+	T->Edges = Storage->Edges;
+	T->Triangles = Storage->Triangles;
+	T->EdgeStack = Storage->EdgeStack;
+}
+
+template<typename kernel>
+size_t GetTriangulationMemorySize(int MaxVertexCount)
+{
+	size_t Result = 0;
+	Result += MaxVertexCount * (sizeof(vertex<kernel>) + sizeof(int));
+	Result += 3 * MaxVertexCount * (sizeof(edge) + sizeof(int));
+	Result += 2 * MaxVertexCount * sizeof(triangle);
+	// NOTE(hugo) : Alignment padding
+	Result += 16 * 5;
+
+	return(Result);
+}
+
+template<typename kernel>
+void PushTriangulation(memory_arena* Arena, triangulation<kernel>* T, int MaxVertexCount)
+{
+	*T = {};
+	T->MaxVertexCount = MaxVertexCount;
+	T->Vertices = PushArray(Arena, MaxVertexCount, vertex<kernel>);
+	T->VertexTriangleIndices = PushArray(Arena, MaxVertexCount, int);
+	T->Edges = PushArray(Arena, 3 * MaxVertexCount, edge);
+	T->Triangles = PushArray(Arena, 2 * MaxVertexCount, triangle);
+	T->EdgeStack = PushArray(Arena, 3 * MaxVertexCount, int);
+}
 
-bool IsVertexInTriangle(triangulation* T, int VIndex, int FIndex)
+
+template<typename kernel>
+bool IsVertexInTriangle(triangulation<kernel>* T, int VIndex, int FIndex)
 {
 	triangle F = T->Triangles[FIndex];
 	for(int i = 0; i < ArrayCount(F.VertexIndices); ++i)
@@ -155,7 +175,8 @@ bool IsVertexInTriangle(triangulation* T, int VIndex, int FIndex)
 	return(false);
 }
 
-bool IsEdgeInTriangle(triangulation* T, int AIndex, int BIndex, int FIndex)
+template<typename kernel>
+bool IsEdgeInTriangle(triangulation<kernel>* T, int AIndex, int BIndex, int FIndex)
 {
 	triangle F = T->Triangles[FIndex];
 	for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
@@ -172,7 +193,8 @@ bool IsEdgeInTriangle(triangulation* T, int AIndex, int BIndex, int FIndex)
 	return(false);
 }
 
-bool IsTriangleValid(triangulation* T, int FIndex)
+template<typename kernel>
+bool IsTriangleValid(triangulation<kernel>* T, int FIndex)
 {
 	triangle F = T->Triangles[FIndex];
 
@@ -219,7 +241,8 @@ bool IsTriangleValid(triangulation* T, int FIndex)
 	return(true);
 }
 
-bool IsTriangulationValid(triangulation* T)
+template<typename kernel>
+bool IsTriangulationValid(triangulation<kernel>* T)
 {
 	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
 	{
@@ -228,44 +251,134 @@ bool IsTriangulationValid(triangulation* T)
 			return(false);
 		}
 	}
+	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	{
+		int TriangleIndex = T->VertexTriangleIndices[VertexIndex];
+		if((TriangleIndex < 0) || (TriangleIndex >= T->TriangleCount) || !IsVertexInTriangle(T, VertexIndex, TriangleIndex))
+		{
+			return(false);
+		}
+	}
 	return(true);
 }
 
-int PushVertex(triangulation* T, vertex V)
+template<typename kernel>
+int PushVertex(triangulation<kernel>* T, vertex<kernel> V)
 {
-	Assert(T->VertexCount < ArrayCount(T->Vertices));
+	Assert(T->VertexCount < T->MaxVertexCount);
+	Assert(kernel::IsInRange(V.x));
+	Assert(kernel::IsInRange(V.y));
 	T->Vertices[T->VertexCount] = V;
 	T->VertexCount++;
 
 	return(T->VertexCount - 1);
 }
 
-int PushEdge(triangulation* T, edge E)
+template<typename kernel>
+int PushEdge(triangulation<kernel>* T, edge E)
 {
-	Assert(T->EdgeCount < ArrayCount(T->Edges));
+	Assert(T->EdgeCount < 3 * T->MaxVertexCount);
+	E.TriangleIndices[0] = -1;
+	E.TriangleIndices[1] = -1;
 	T->Edges[T->EdgeCount] = E;
 	T->EdgeCount++;
 
 	return(T->EdgeCount - 1);
 }
 
-int PushTriangle(triangulation* T, triangle F)
+template<typename kernel>
+void AttachTriangleToEdge(triangulation<kernel>* T, int EdgeIndex, int TriangleIndex)
+{
+	edge* E = T->Edges + EdgeIndex;
+	if(E->TriangleIndices[0] == -1)
+	{
+		E->TriangleIndices[0] = TriangleIndex;
+	}
+	else
+	{
+		Assert(E->TriangleIndices[1] == -1); //NOTE(hugo) : more than two triangles incident to a single edge ???
+		E->TriangleIndices[1] = TriangleIndex;
+	}
+}
+
+template<typename kernel>
+void DetachTriangleFromEdge(triangulation<kernel>* T, int EdgeIndex, int TriangleIndex)
+{
+	edge* E = T->Edges + EdgeIndex;
+	if(E->TriangleIndices[0] == TriangleIndex)
+	{
+		E->TriangleIndices[0] = E->TriangleIndices[1];
+		E->TriangleIndices[1] = -1;
+	}
+	else
+	{
+		Assert(E->TriangleIndices[1] == TriangleIndex);
+		E->TriangleIndices[1] = -1;
+	}
+}
+
+template<typename kernel>
+void ReplaceTriangleOfEdge(triangulation<kernel>* T, int EdgeIndex, int OldTriangleIndex, int NewTriangleIndex)
+{
+	edge* E = T->Edges + EdgeIndex;
+	if(E->TriangleIndices[0] == OldTriangleIndex)
+	{
+		E->TriangleIndices[0] = NewTriangleIndex;
+	}
+	else
+	{
+		Assert(E->TriangleIndices[1] == OldTriangleIndex);
+		E->TriangleIndices[1] = NewTriangleIndex;
+	}
+}
+
+template<typename kernel>
+int PushTriangle(triangulation<kernel>* T, triangle F)
 {
-	Assert(T->TriangleCount < ArrayCount(T->Triangles));
-	T->Triangles[T->TriangleCount] = F;
+	Assert(T->TriangleCount < 2 * T->MaxVertexCount);
+	int TriangleIndex = T->TriangleCount;
+	T->Triangles[TriangleIndex] = F;
 	T->TriangleCount++;
 
-	return(T->TriangleCount - 1);
+	for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
+	{
+		AttachTriangleToEdge(T, F.EdgeIndices[i], TriangleIndex);
+		T->VertexTriangleIndices[F.VertexIndices[i]] = TriangleIndex;
+	}
+
+	return(TriangleIndex);
 }
 
-void DeleteTriangle(triangulation* T, int TriangleIndex)
+template<typename kernel>
+void DeleteTriangle(triangulation<kernel>* T, int TriangleIndex)
 {
 	Assert(T->TriangleCount > 0);
-	T->Triangles[TriangleIndex] = T->Triangles[T->TriangleCount - 1];
+	triangle F = T->Triangles[TriangleIndex];
+	for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
+	{
+		DetachTriangleFromEdge(T, F.EdgeIndices[i], TriangleIndex);
+	}
+
+	int LastTriangleIndex = T->TriangleCount - 1;
+	if(TriangleIndex != LastTriangleIndex)
+	{
+		// NOTE(hugo) : The last triangle is moved into the freed slot, its edges must follow.
+		triangle LastTriangle = T->Triangles[LastTriangleIndex];
+		for(int i = 0; i < ArrayCount(LastTriangle.EdgeIndices); ++i)
+		{
+			ReplaceTriangleOfEdge(T, LastTriangle.EdgeIndices[i], LastTriangleIndex, TriangleIndex);
+			if(T->VertexTriangleIndices[LastTriangle.VertexIndices[i]] == LastTriangleIndex)
+			{
+				T->VertexTriangleIndices[LastTriangle.VertexIndices[i]] = TriangleIndex;
+			}
+		}
+		T->Triangles[TriangleIndex] = LastTriangle;
+	}
 	T->TriangleCount--;
 }
 
-bool AreTwoTrianglesIdentical(triangulation* T, int* F0Index, int* F1Index)
+template<typename kernel>
+bool AreTwoTrianglesIdentical(triangulation<kernel>* T, int* F0Index, int* F1Index)
 {
 	for(int FirstTriangleIndex = 0; FirstTriangleIndex < (T->TriangleCount - 1); ++FirstTriangleIndex)
 	{
@@ -292,90 +405,182 @@ bool AreTwoTrianglesIdentical(triangulation* T, int* F0Index, int* F1Index)
 	return(false);
 }
 
-bool GetTrianglesOfEdge(triangulation* T, int EdgeIndex, int* F0Index, int* F1Index)
+template<typename kernel>
+bool GetTrianglesOfEdge(triangulation<kernel>* T, int EdgeIndex, int* F0Index, int* F1Index)
 {
-	// TODO(hugo) : This function could be considerably improved if I changed my data structure
-	// and if an edge would reference its incident triangles
-	bool F0Found = false;
-	bool F1Found = false;
-	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
+	edge E = T->Edges[EdgeIndex];
+	Assert(E.TriangleIndices[0] != -1);
+	*F0Index = E.TriangleIndices[0];
+	if(E.TriangleIndices[1] != -1)
 	{
-		triangle F = T->Triangles[TriangleIndex];
-		for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
-		{
-			if(EdgeIndex == F.EdgeIndices[i])
-			{
-				if(!F0Found)
-				{
-					*F0Index = TriangleIndex;
-					F0Found = true;
-					break;
-				}
-				else if(!F1Found)
-				{
-					*F1Index = TriangleIndex;
-					F1Found = true;
-					break;
-				}
-				else
-				{
-					Assert(false); //NOTE(hugo) : more than two triangles incident to a single edge ???
-				}
-			}
-		}
-		if(F0Found && F1Found)
-		{
-			return(true);
-		}
+		*F1Index = E.TriangleIndices[1];
+		return(true);
 	}
 
-	Assert(F0Found);
-	Assert(!F1Found);
 	return(false);
 }
 
-bool IsCounterClockWise(vertex A, vertex B, vertex C)
+/*
+ * NOTE(hugo) : The symbolic super triangle has its vertices at R d0, R d1 and R d2 with d0 = (1, -e),
+ * d1 = (-e^2, 1) and d2 = (-1, -2e), R going to infinity first and e going to 0 afterwards. It holds any point,
+ * and the predicates involving it reduce to signs of coordinate differences, so they are exact in every kernel
+ * and never overflow. Nothing is ever aligned with or cocircular to a vertex at infinity : the real triangles
+ * are exactly the Delaunay triangulation of the real points, with the whole convex hull.
+ */
+
+template<typename kernel>
+int OrientationAtInfinity(vertex<kernel> A, vertex<kernel> B, vertex<kernel> C)
+{
+	if(A.IsAtInfinity && B.IsAtInfinity && C.IsAtInfinity)
+	{
+		// NOTE(hugo) : d0, d1 and d2 are counter clockwise
+		return((int(B.x) == (int(A.x) + 1) % 3) ? 1 : -1);
+	}
+
+	// NOTE(hugo) : A rotation keeps the orientation, so A is made finite and C infinite
+	while(A.IsAtInfinity || !C.IsAtInfinity)
+	{
+		vertex<kernel> Temp = A;
+		A = B;
+		B = C;
+		C = Temp;
+	}
+	int CDirection = int(C.x);
+	if(B.IsAtInfinity)
+	{
+		// NOTE(hugo) : R^2 cross(dB, dC) wins, and it is positive from each direction to the next one
+		return((CDirection == (int(B.x) + 1) % 3) ? 1 : -1);
+	}
+
+	// NOTE(hugo) : The sign of cross(B - A, dC) with dC = u + e v (+ e^2 v for d1), u first and then v.
+	// cross(B - A, (a, b)) is b (B.x - A.x) - a (B.y - A.y).
+	static const int Us[3][2] = {{1, 0}, {0, 1}, {-1, 0}};
+	static const int Vs[3][2] = {{0, -1}, {-1, 0}, {0, -1}};
+	int Result = kernel::LinearSign(A, B, Us[CDirection][1], -Us[CDirection][0]);
+	if(Result == 0)
+	{
+		Result = kernel::LinearSign(A, B, Vs[CDirection][1], -Vs[CDirection][0]);
+	}
+
+	return(Result);
+}
+
+template<typename kernel>
+int Orientation(vertex<kernel> A, vertex<kernel> B, vertex<kernel> C)
 {
-	float CrossProductZ = (B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x);
-	bool IsCCW = (CrossProductZ > 0);
+	// NOTE(hugo) : 1 if C is on the left of AB, -1 if it is on the right, 0 if ABC are aligned
+	if(A.IsAtInfinity || B.IsAtInfinity || C.IsAtInfinity)
+	{
+		return(OrientationAtInfinity(A, B, C));
+	}
+	int Result = kernel::Orient2D(A, B, C);
+
+	return(Result);
+}
+
+template<typename kernel>
+bool IsCounterClockWise(vertex<kernel> A, vertex<kernel> B, vertex<kernel> C)
+{
+	bool IsCCW = (Orientation(A, B, C) > 0);
 
 	return(IsCCW);
 }
 
-struct barycentric_coords
+template<typename kernel>
+bool IsInDirection(vertex<kernel> A, vertex<kernel> B, vertex<kernel> P)
 {
-	float Alpha;
-	float Beta;
-	float Gamma;
-};
+	// NOTE(hugo) : For P aligned with AB, is P on the same side of A as B ? Only comparisons, so it cannot overflow.
+	bool SameX = (((P.x > A.x) - (P.x < A.x)) == ((B.x > A.x) - (B.x < A.x)));
+	bool SameY = (((P.y > A.y) - (P.y < A.y)) == ((B.y > A.y) - (B.y < A.y)));
 
-barycentric_coords FindBarycentricCoordsOfPointInTriangle(triangulation* T, triangle F, vertex V)
+	return(SameX && SameY && ((P.x != A.x) || (P.y != A.y)));
+}
+
+template<typename kernel>
+bool IsInCircumcircleAtInfinity(vertex<kernel> A, vertex<kernel> B, vertex<kernel> C, vertex<kernel> D)
 {
-	barycentric_coords Result = {};
-	vertex A = T->Vertices[F.Vertex0Index];
-	vertex B = T->Vertices[F.Vertex1Index];
-	vertex C = T->Vertices[F.Vertex2Index];
-	float TriangleArea = 0.5f * (-B.y * C.x + A.y * (-B.x + C.x) + A.x * (B.y - C.y) + B.x * C.y);
-	//float Sign = TriangleArea > 0 ? 1.0f : -1.0f;
-	float s = (1.0f / (2.0f * TriangleArea)) * (A.y * C.x - A.x * C.y + (C.y - A.y) * V.x + (A.x - C.x) * V.y);
-	float t = (1.0f / (2.0f * TriangleArea)) * (A.x * B.y - A.y * B.x + (A.y - B.y) * V.x + (B.x - A.x) * V.y);
+	// NOTE(hugo) : ABC is counter clockwise with at least one vertex at infinity, D is finite
+	if(A.IsAtInfinity && B.IsAtInfinity && C.IsAtInfinity)
+	{
+		return(true);
+	}
+
+	while(A.IsAtInfinity || !C.IsAtInfinity)
+	{
+		vertex<kernel> Temp = A;
+		A = B;
+		B = C;
+		C = Temp;
+	}
+	if(!B.IsAtInfinity)
+	{
+		// NOTE(hugo) : The circle becomes the half plane on the left of AB, and of AB itself only the
+		// part strictly between A and B is inside
+		int Side = kernel::Orient2D(A, B, D);
+		return((Side > 0) || ((Side == 0) && IsInDirection(A, B, D) && IsInDirection(B, A, D)));
+	}
 
-	Result.Beta = s;
-	Result.Gamma = t;
-	Result.Alpha = 1.0f - Result.Beta - Result.Gamma;
+	// NOTE(hugo) : B and C are R di and R di+1. The circle becomes a half plane through A, the sign of
+	// (D - A).n decides with the normal n = n0 + e n1 pointing inside, n0 first and then n1.
+	int BDirection = int(B.x);
+	Assert(int(C.x) == (BDirection + 1) % 3);
+	static const int Normals[3][2][2] =
+	{
+		{{ 1, 1}, { 1, 0}},
+		{{-1, 1}, {-1, 0}},
+		{{ 0, -1}, { 1, 0}},
+	};
+	int Result = kernel::LinearSign(A, D, Normals[BDirection][0][0], Normals[BDirection][0][1]);
+	if(Result == 0)
+	{
+		Result = kernel::LinearSign(A, D, Normals[BDirection][1][0], Normals[BDirection][1][1]);
+	}
 
-	return(Result);
+	return(Result > 0);
+}
+
+template<typename kernel>
+bool IsInCircumcircle(vertex<kernel> A, vertex<kernel> B, vertex<kernel> C, vertex<kernel> D)
+{
+	// NOTE(hugo) : Is D strictly inside the circle going through A, B and C ?
+	Assert(!D.IsAtInfinity);
+	int ABCOrientation = Orientation(A, B, C);
+	if(ABCOrientation == 0)
+	{
+		return(false);
+	}
+	if(ABCOrientation < 0)
+	{
+		vertex<kernel> Temp = B;
+		B = C;
+		C = Temp;
+	}
+	if(A.IsAtInfinity || B.IsAtInfinity || C.IsAtInfinity)
+	{
+		return(IsInCircumcircleAtInfinity(A, B, C, D));
+	}
+
+	return(kernel::InCircle(A, B, C, D) > 0);
 }
 
-bool IsInTriangle(triangulation* T, triangle F, vertex V)
+template<typename kernel>
+bool IsInTriangle(triangulation<kernel>* T, triangle F, vertex<kernel> V)
 {
-	barycentric_coords Bar = FindBarycentricCoordsOfPointInTriangle(T, F, V);
-	bool IsInside = (Bar.Alpha > 0 && Bar.Beta > 0 && Bar.Gamma > 0);
+	// NOTE(hugo) : V is strictly inside if it is strictly on the same side of the three edges as the triangle itself
+	vertex<kernel> A = T->Vertices[F.Vertex0Index];
+	vertex<kernel> B = T->Vertices[F.Vertex1Index];
+	vertex<kernel> C = T->Vertices[F.Vertex2Index];
+	int TriangleOrientation = Orientation(A, B, C);
+	bool IsInside = (TriangleOrientation != 0)
+		&& (Orientation(A, B, V) == TriangleOrientation)
+		&& (Orientation(B, C, V) == TriangleOrientation)
+		&& (Orientation(C, A, V) == TriangleOrientation);
 
 	return(IsInside);
 }
 
-int FindEdgeIndexLinkingVertices(triangulation* T, int PIndex, int QIndex, triangle F)
+template<typename kernel>
+int FindEdgeIndexLinkingVertices(triangulation<kernel>* T, int PIndex, int QIndex, triangle F)
 {
 	for(int EdgeIndex = 0; EdgeIndex < ArrayCount(F.EdgeIndices); ++EdgeIndex)
 	{
@@ -392,7 +597,8 @@ int FindEdgeIndexLinkingVertices(triangulation* T, int PIndex, int QIndex, trian
 	return(0);
 }
 
-int FindVertexIndexNotInEdgeInTriangle(triangulation* T, int EdgeIndex, int FIndex)
+template<typename kernel>
+int FindVertexIndexNotInEdgeInTriangle(triangulation<kernel>* T, int EdgeIndex, int FIndex)
 {
 	// NOTE(hugo) : We assume that the triangle is ABC and the edge is BC. We are therefore looking for A.
 	int BIndex = T->Edges[EdgeIndex].Vertex0Index;
@@ -419,7 +625,8 @@ struct common_edge_result
 	int DIndex;
 };
 
-common_edge_result FindEdgeIndexInCommonBetweenTriangles(triangulation* T, int F0Index, int F1Index)
+template<typename kernel>
+common_edge_result FindEdgeIndexInCommonBetweenTriangles(triangulation<kernel>* T, int F0Index, int F1Index)
 {
 	common_edge_result Result = {};
 	triangle F0 = T->Triangles[F0Index];
@@ -444,69 +651,44 @@ common_edge_result FindEdgeIndexInCommonBetweenTriangles(triangulation* T, int F
 	return(Result);
 }
 
-bool IsDelaunay(triangulation* T, int TriangleIndex)
+template<typename kernel>
+bool IsEdgeLocallyDelaunay(triangulation<kernel>* T, int F0Index, int F1Index)
 {
-	triangle F = T->Triangles[TriangleIndex];
-	vertex A = T->Vertices[F.Vertex0Index];
-	vertex B = T->Vertices[F.Vertex1Index];
-	vertex C = T->Vertices[F.Vertex2Index];
-
-	if(!IsCounterClockWise(A, B, C))
+	// NOTE(hugo) : F0 (ABC) and F1 (BCD) share the edge BC. It is locally Delaunay if D is not in the circle of ABC.
+	// We only trust the test when the vertex being tested is a real one, the fake ones are too far away.
+	common_edge_result CommonEdgeResult = FindEdgeIndexInCommonBetweenTriangles(T, F0Index, F1Index);
+	edge BC = T->Edges[CommonEdgeResult.BCIndex];
+	vertex<kernel> A = T->Vertices[CommonEdgeResult.AIndex];
+	vertex<kernel> B = T->Vertices[BC.Vertex0Index];
+	vertex<kernel> C = T->Vertices[BC.Vertex1Index];
+	vertex<kernel> D = T->Vertices[CommonEdgeResult.DIndex];
+
+	// NOTE(hugo) : If ABDC is not strictly convex, AD would not be inside the quad and BC cannot be flipped anyway
+	if(Orientation(A, D, B) * Orientation(A, D, C) >= 0)
 	{
-		vertex Temp = B;
-		B = C;
-		C = Temp;
-		Assert(IsCounterClockWise(A, B, C));
+		return(true);
 	}
 
-	mat4 M = {};
-	SetValue(&M, 0, 0, A.x);
-	SetValue(&M, 0, 1, A.y);
-	SetValue(&M, 0, 2, A.x * A.x + A.y * A.y);
-	SetValue(&M, 0, 3, 1);
-
-	SetValue(&M, 1, 0, B.x);
-	SetValue(&M, 1, 1, B.y);
-	SetValue(&M, 1, 2, B.x * B.x + B.y * B.y);
-	SetValue(&M, 1, 3, 1);
-
-	SetValue(&M, 2, 0, C.x);
-	SetValue(&M, 2, 1, C.y);
-	SetValue(&M, 2, 2, C.x * C.x + C.y * C.y);
-	SetValue(&M, 2, 3, 1);
-
-	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	if(D.IsRealPoint)
 	{
-		vertex D = T->Vertices[VertexIndex];
-		if(D.IsRealPoint)
-		{
-			if((VertexIndex !=  F.Vertex0Index) && (VertexIndex != F.Vertex1Index) && (VertexIndex != F.Vertex2Index))
-			{
-
-				SetValue(&M, 3, 0, D.x);
-				SetValue(&M, 3, 1, D.y);
-				SetValue(&M, 3, 2, D.x * D.x + D.y * D.y);
-				SetValue(&M, 3, 3, 1);
-
-				float Determinant = Det(M);
-				if(Determinant > 0)
-				{
-					// TODO(hugo) : There is a big optim to be done. If we found the vertex that is inside the circle, we directly have the other triangle that we need to flip the edge with.
-					return(false);
-				}
-			}
-		}
+		return(!IsInCircumcircle(A, B, C, D));
+	}
+	if(A.IsRealPoint)
+	{
+		return(!IsInCircumcircle(D, B, C, A));
 	}
 
 	return(true);
-
 }
 
-void PerformLawsonFlip(triangulation* T, int F0Index, int F1Index)
+template<typename kernel>
+void PerformLawsonFlip(triangulation<kernel>* T, int F0Index, int F1Index)
 {
+#if DELONE_SLOW
 	int FId0;
 	int FId1;
 	Assert(!AreTwoTrianglesIdentical(T, &FId0, &FId1));
+#endif
 	Assert(IsTriangleValid(T, F0Index));
 	Assert(IsTriangleValid(T, F1Index));
 
@@ -557,28 +739,42 @@ void PerformLawsonFlip(triangulation* T, int F0Index, int F1Index)
 	T->Triangles[F1Index].Edge1Index = DCIndex;
 	T->Triangles[F1Index].Edge2Index = ADIndex;
 
+	// NOTE(hugo) : AB and DC stay with the same triangle, DB moved to F0 and AC moved to F1
+	ReplaceTriangleOfEdge(T, DBIndex, F1Index, F0Index);
+	ReplaceTriangleOfEdge(T, ACIndex, F0Index, F1Index);
+	// NOTE(hugo) : A and D are in both triangles, B is only left in F0 and C in F1
+	T->VertexTriangleIndices[BIndex] = F0Index;
+	T->VertexTriangleIndices[CIndex] = F1Index;
 
 	Assert(IsTriangleValid(T, F0Index));
 	Assert(IsTriangleValid(T, F1Index));
 
+#if DELONE_SLOW
 	Assert(!AreTwoTrianglesIdentical(T, &FId0, &FId1));
+#endif
 }
 
-void Render(SDL_Renderer* Renderer, triangulation* T, TTF_Font* Font)
+template<typename kernel>
+void Render(SDL_Renderer* Renderer, triangulation<kernel>* T, TTF_Font* Font)
 {
-	// NOTE(hugo) : Rendering !
+	// NOTE(hugo) : Rendering ! There is no renderer when replaying without a window.
+	if(!Renderer)
+	{
+		return;
+	}
+
 	SDL_SetRenderDrawColor(Renderer, 119, 136, 153, 255);
 	SDL_RenderClear(Renderer);
 	SDL_SetRenderDrawColor(Renderer, 20, 20, 20, 255);
 
 	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
 	{
-		vertex V = T->Vertices[VertexIndex];
+		vertex<kernel> V = T->Vertices[VertexIndex];
 		if(V.IsRealPoint)
 		{
 			SDL_Rect VertexRect;
-			VertexRect.x = V.x - 2;
-			VertexRect.y = ScreenHeight - V.y - 2;
+			VertexRect.x = (int)V.x - 2;
+			VertexRect.y = ScreenHeight - (int)V.y - 2;
 			VertexRect.w = 5;
 			VertexRect.h = 5;
 			SDL_RenderDrawRect(Renderer, &VertexRect);
@@ -588,11 +784,19 @@ void Render(SDL_Renderer* Renderer, triangulation* T, TTF_Font* Font)
 	for(int EdgeIndex = 0; EdgeIndex < T->EdgeCount; ++EdgeIndex)
 	{
 		edge E = T->Edges[EdgeIndex];
-		vertex V = T->Vertices[E.Vertex0Index];
-		vertex W = T->Vertices[E.Vertex1Index];
+		vertex<kernel> V = T->Vertices[E.Vertex0Index];
+		vertex<kernel> W = T->Vertices[E.Vertex1Index];
 		if(V.IsRealPoint && W.IsRealPoint)
 		{
-			SDL_RenderDrawLine(Renderer, V.x, ScreenHeight - V.y, W.x, ScreenHeight - W.y);
+			if(E.IsConstrained)
+			{
+				SDL_SetRenderDrawColor(Renderer, 178, 34, 34, 255);
+			}
+			SDL_RenderDrawLine(Renderer, (int)V.x, ScreenHeight - (int)V.y, (int)W.x, ScreenHeight - (int)W.y);
+			if(E.IsConstrained)
+			{
+				SDL_SetRenderDrawColor(Renderer, 20, 20, 20, 255);
+			}
 		}
 	}
 
@@ -674,34 +878,75 @@ void Render(SDL_Renderer* Renderer, triangulation* T, TTF_Font* Font)
 }
 
 
-void ComputeDelaunay(triangulation* T, SDL_Renderer* Renderer, TTF_Font* Font)
+template<typename kernel>
+void InitTriangulation(triangulation<kernel>* T, vertex<kernel> FakePoint0, vertex<kernel> FakePoint1, vertex<kernel> FakePoint2)
 {
-	int SIndex = T->VertexCount - 1;
-	vertex S = T->Vertices[SIndex];
-	Assert(S.IsRealPoint);
+	// NOTE(hugo) : Starts over with only the super triangle, every real point must be strictly inside it
+	T->VertexCount = 0;
+	T->EdgeCount = 0;
+	T->TriangleCount = 0;
+
+	edge E01 = {0, 1, false, {-1, -1}};
+	edge E12 = {1, 2, false, {-1, -1}};
+	edge E20 = {2, 0, false, {-1, -1}};
+	triangle F = {0, 1, 2, 0, 1, 2};
+	PushVertex(T, FakePoint0);
+	PushVertex(T, FakePoint1);
+	PushVertex(T, FakePoint2);
+	PushEdge(T, E01);
+	PushEdge(T, E12);
+	PushEdge(T, E20);
+	PushTriangle(T, F);
+}
 
-	int TriangleToBeSplitIndex = -1;
-	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
-	{
-		triangle F = T->Triangles[TriangleIndex];
-		if(IsInTriangle(T, F, S))
-		{
-			TriangleToBeSplitIndex = TriangleIndex;
-			break;
-		}
-	}
-	
-	// NOTE(hugo) : Creating new triangles
-	Assert(TriangleToBeSplitIndex != -1);
+template<typename kernel>
+void InitTriangulationWithSuperTriangle(triangulation<kernel>* T, typename kernel::coord Min, typename kernel::coord Max)
+{
+	// NOTE(hugo) : Super triangle for points in the square [Min, Max] x [Min, Max] : a right triangle 48 times
+	// the size of the square, with the square 16 sizes away from its two legs. The caller checks that its
+	// corners are in the kernel range.
+	typedef typename kernel::coord coord;
+	coord Size = Max - Min + 1;
+	vertex<kernel> FakePoint0 = {Min - 16 * Size, Min - 16 * Size, false};
+	vertex<kernel> FakePoint1 = {Min + 32 * Size, Min - 16 * Size, false};
+	vertex<kernel> FakePoint2 = {Min - 16 * Size, Min + 32 * Size, false};
+	InitTriangulation(T, FakePoint0, FakePoint1, FakePoint2);
+}
+
+template<typename kernel>
+void InitTriangulationAtInfinity(triangulation<kernel>* T)
+{
+	// NOTE(hugo) : Starts over with only the symbolic super triangle, any point in the kernel range can go in
+	vertex<kernel> FakePoint0 = {0, 0, false, true};
+	vertex<kernel> FakePoint1 = {1, 0, false, true};
+	vertex<kernel> FakePoint2 = {2, 0, false, true};
+	InitTriangulation(T, FakePoint0, FakePoint1, FakePoint2);
+}
+
+uint32_t XorShift32(uint32_t* State)
+{
+	uint32_t x = *State;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*State = x;
+
+	return(x);
+}
+
+template<typename kernel>
+void SplitTriangle(triangulation<kernel>* T, int TriangleToBeSplitIndex, int SIndex)
+{
+	// NOTE(hugo) : S is strictly inside PQR, which is replaced by QSP, QSR and SRP at the end of the triangle array
 	triangle TriangleToBeSplit = T->Triangles[TriangleToBeSplitIndex];
 
 	int PIndex = TriangleToBeSplit.Vertex0Index;
 	int QIndex = TriangleToBeSplit.Vertex1Index;
 	int RIndex = TriangleToBeSplit.Vertex2Index;
 
-	edge SP = {SIndex, PIndex};
-	edge SQ = {SIndex, QIndex};
-	edge SR = {SIndex, RIndex};
+	edge SP = {SIndex, PIndex, false, {-1, -1}};
+	edge SQ = {SIndex, QIndex, false, {-1, -1}};
+	edge SR = {SIndex, RIndex, false, {-1, -1}};
 
 	int SPIndex = PushEdge(T, SP);
 	int SQIndex = PushEdge(T, SQ);
@@ -719,6 +964,35 @@ void ComputeDelaunay(triangulation* T, SDL_Renderer* Renderer, TTF_Font* Font)
 	PushTriangle(T, QSP);
 	PushTriangle(T, QSR);
 	PushTriangle(T, SRP);
+}
+
+template<typename kernel>
+bool ComputeDelaunay(triangulation<kernel>* T, SDL_Renderer* Renderer, TTF_Font* Font)
+{
+	// NOTE(hugo) : Inserts the last vertex pushed. When it is not strictly inside a triangle (on an edge or on
+	// another vertex) it is popped and false is returned, the triangulation is left as it was.
+	int SIndex = T->VertexCount - 1;
+	vertex<kernel> S = T->Vertices[SIndex];
+	Assert(S.IsRealPoint);
+
+	int TriangleToBeSplitIndex = -1;
+	for(int TriangleIndex = 0; TriangleIndex < T->TriangleCount; ++TriangleIndex)
+	{
+		triangle F = T->Triangles[TriangleIndex];
+		if(IsInTriangle(T, F, S))
+		{
+			TriangleToBeSplitIndex = TriangleIndex;
+			break;
+		}
+	}
+	if(TriangleToBeSplitIndex == -1)
+	{
+		T->VertexCount--;
+		return(false);
+	}
+
+	// NOTE(hugo) : Creating new triangles
+	SplitTriangle(T, TriangleToBeSplitIndex, SIndex);
 
 	Render(Renderer, T, Font);
 
@@ -729,10 +1003,15 @@ void ComputeDelaunay(triangulation* T, SDL_Renderer* Renderer, TTF_Font* Font)
 		NeedNewFlipCheck = false;
 		for(int EdgeIndex = 0; EdgeIndex < T->EdgeCount; ++EdgeIndex)
 		{
+			if(T->Edges[EdgeIndex].IsConstrained)
+			{
+				continue;
+			}
+
 			int F0Index = 0;
 			int F1Index = 1;
 			bool GotTriangles = GetTrianglesOfEdge(T, EdgeIndex, &F0Index, &F1Index);
-			if(GotTriangles && ((!IsDelaunay(T, F0Index)) && (!IsDelaunay(T, F1Index))))
+			if(GotTriangles && !IsEdgeLocallyDelaunay(T, F0Index, F1Index))
 			{
 				Render(Renderer, T, Font);
 				PerformLawsonFlip(T, F0Index, F1Index);
@@ -742,14 +1021,2081 @@ void ComputeDelaunay(triangulation* T, SDL_Renderer* Renderer, TTF_Font* Font)
 		}
 	}
 
+	return(true);
 }
 
-int main(int ArgumentCount, char** Arguments)
+/* ------------------------------
+ *     headless insertion
+ * ------------------------------ */
+
+// NOTE(hugo) : ComputeDelaunay is written for the interactive case : it scans every triangle to find the new
+// point and re-checks every edge after each flip. InsertVertex finds the new point by walking from the last
+// triangle created and only re-checks the edges facing it, so an insertion costs the walk and the number of
+// triangles around the new vertex. A point on an edge splits that edge, a point on an existing vertex is rejected.
+
+struct point_location
 {
-	SDL_Init(SDL_INIT_EVERYTHING);
+	// NOTE(hugo) : The triangle containing the point, the edge it lies on and the vertex it is equal to (-1 if none)
+	int TriangleIndex;
+	int EdgeIndex;
+	int VertexIndex;
+};
 
-	SDL_Window* Window = SDL_CreateWindow("Delaunay Triangulation", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, ScreenWidth, ScreenHeight, 0);
-	Assert(Window);
+template<typename kernel>
+int FindOtherTriangleOfEdge(triangulation<kernel>* T, int EdgeIndex, int TriangleIndex)
+{
+	edge E = T->Edges[EdgeIndex];
+	int Result = (E.TriangleIndices[0] == TriangleIndex) ? E.TriangleIndices[1] : E.TriangleIndices[0];
+
+	return(Result);
+}
+
+template<typename kernel>
+point_location LocateVertex(triangulation<kernel>* T, vertex<kernel> V, int StartTriangleIndex)
+{
+	// NOTE(hugo) : Walks from triangle to triangle, always crossing an edge that has V strictly on its other side.
+	// The first edge tested is drawn at random at every step : once constraints are in, the triangulation is
+	// no longer Delaunay and a walk with a fixed order could cycle.
+	point_location Result = {-1, -1, -1};
+	int TriangleIndex = StartTriangleIndex;
+	uint32_t WalkState = 2463534242u;
+	while(Result.TriangleIndex == -1)
+	{
+		int FirstEdge = XorShift32(&WalkState) % 3;
+
+		triangle F = T->Triangles[TriangleIndex];
+		int NextTriangleIndex = -1;
+		int OnEdgeCount = 0;
+		int OnEdgeIndex = -1;
+		for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
+		{
+			int EdgeIndex = F.EdgeIndices[(FirstEdge + i) % 3];
+			edge E = T->Edges[EdgeIndex];
+			vertex<kernel> A = T->Vertices[E.Vertex0Index];
+			vertex<kernel> B = T->Vertices[E.Vertex1Index];
+			vertex<kernel> C = T->Vertices[FindVertexIndexNotInEdgeInTriangle(T, EdgeIndex, TriangleIndex)];
+			int Side = Orientation(A, B, V) * Orientation(A, B, C);
+			if(Side < 0)
+			{
+				NextTriangleIndex = FindOtherTriangleOfEdge(T, EdgeIndex, TriangleIndex);
+				// NOTE(hugo) : V is outside of the super triangle ?
+				Assert(NextTriangleIndex != -1);
+				break;
+			}
+			if(Side == 0)
+			{
+				OnEdgeCount++;
+				OnEdgeIndex = EdgeIndex;
+			}
+		}
+
+		if(NextTriangleIndex != -1)
+		{
+			TriangleIndex = NextTriangleIndex;
+		}
+		else
+		{
+			Result.TriangleIndex = TriangleIndex;
+			if(OnEdgeCount == 1)
+			{
+				Result.EdgeIndex = OnEdgeIndex;
+			}
+			else if(OnEdgeCount == 2)
+			{
+				for(int i = 0; i < ArrayCount(F.VertexIndices); ++i)
+				{
+					vertex<kernel> W = T->Vertices[F.VertexIndices[i]];
+					if(W.IsRealPoint && (W.x == V.x) && (W.y == V.y))
+					{
+						Result.VertexIndex = F.VertexIndices[i];
+					}
+				}
+				Assert(Result.VertexIndex != -1);
+			}
+		}
+	}
+
+	return(Result);
+}
+
+template<typename kernel>
+void SplitEdge(triangulation<kernel>* T, int BCIndex, int SIndex)
+{
+	// NOTE(hugo) : S is strictly inside BC, shared by ABC and BCD. Both triangles are replaced by ABS, ASC, DBS and DSC
+	// at the end of the triangle array. BC keeps its index as BS, and a constraint stays a constraint on both halves.
+	int F0Index = 0;
+	int F1Index = 0;
+	bool GotTriangles = GetTrianglesOfEdge(T, BCIndex, &F0Index, &F1Index);
+	// NOTE(hugo) : S would be on the super triangle border
+	Assert(GotTriangles);
+
+	edge BC = T->Edges[BCIndex];
+	int BIndex = BC.Vertex0Index;
+	int CIndex = BC.Vertex1Index;
+	int AIndex = FindVertexIndexNotInEdgeInTriangle(T, BCIndex, F0Index);
+	int DIndex = FindVertexIndexNotInEdgeInTriangle(T, BCIndex, F1Index);
+	int ABIndex = FindEdgeIndexLinkingVertices(T, AIndex, BIndex, T->Triangles[F0Index]);
+	int ACIndex = FindEdgeIndexLinkingVertices(T, AIndex, CIndex, T->Triangles[F0Index]);
+	int DBIndex = FindEdgeIndexLinkingVertices(T, DIndex, BIndex, T->Triangles[F1Index]);
+	int DCIndex = FindEdgeIndexLinkingVertices(T, DIndex, CIndex, T->Triangles[F1Index]);
+
+	// NOTE(hugo) : The higher index goes first, otherwise the last triangle could be moved into the other one's slot
+	DeleteTriangle(T, (F0Index > F1Index) ? F0Index : F1Index);
+	DeleteTriangle(T, (F0Index > F1Index) ? F1Index : F0Index);
+
+	T->Edges[BCIndex].Vertex1Index = SIndex;
+	int BSIndex = BCIndex;
+
+	edge SC = {SIndex, CIndex, BC.IsConstrained, {-1, -1}};
+	edge SA = {SIndex, AIndex, false, {-1, -1}};
+	edge SD = {SIndex, DIndex, false, {-1, -1}};
+	int SCIndex = PushEdge(T, SC);
+	int SAIndex = PushEdge(T, SA);
+	int SDIndex = PushEdge(T, SD);
+
+	triangle ABS = {ABIndex, BSIndex, SAIndex, AIndex, BIndex, SIndex};
+	triangle ASC = {SAIndex, SCIndex, ACIndex, AIndex, SIndex, CIndex};
+	triangle DBS = {DBIndex, BSIndex, SDIndex, DIndex, BIndex, SIndex};
+	triangle DSC = {SDIndex, SCIndex, DCIndex, DIndex, SIndex, CIndex};
+
+	PushTriangle(T, ABS);
+	PushTriangle(T, ASC);
+	PushTriangle(T, DBS);
+	PushTriangle(T, DSC);
+}
+
+template<typename kernel>
+void PushEdgesOppositeToVertex(triangulation<kernel>* T, int TriangleIndex, int SIndex, int* EdgeStack, int* EdgeStackCount)
+{
+	triangle F = T->Triangles[TriangleIndex];
+	for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
+	{
+		edge E = T->Edges[F.EdgeIndices[i]];
+		if((E.Vertex0Index != SIndex) && (E.Vertex1Index != SIndex))
+		{
+			Assert(*EdgeStackCount < 3 * T->MaxVertexCount);
+			EdgeStack[(*EdgeStackCount)++] = F.EdgeIndices[i];
+		}
+	}
+}
+
+template<typename kernel>
+int InsertVertex(triangulation<kernel>* T, vertex<kernel> V)
+{
+	// NOTE(hugo) : Returns the index of the new vertex, or -1 if there already is a vertex at this position.
+	// The walk starts from the last triangle created, which is close to the previous point.
+	Assert(V.IsRealPoint);
+	point_location Location = LocateVertex(T, V, T->TriangleCount - 1);
+	if(Location.VertexIndex != -1)
+	{
+		return(-1);
+	}
+
+	int SIndex = PushVertex(T, V);
+	int NewTriangleCount = 3;
+	if(Location.EdgeIndex == -1)
+	{
+		SplitTriangle(T, Location.TriangleIndex, SIndex);
+	}
+	else
+	{
+		SplitEdge(T, Location.EdgeIndex, SIndex);
+		NewTriangleCount = 4;
+	}
+
+	// NOTE(hugo) : Only the edges facing S can stop being locally Delaunay. A flip replaces one of them by an edge
+	// out of S, and the two edges behind it are the next to be checked.
+	int* EdgeStack = T->EdgeStack;
+	int EdgeStackCount = 0;
+	for(int TriangleIndex = T->TriangleCount - NewTriangleCount; TriangleIndex < T->TriangleCount; ++TriangleIndex)
+	{
+		PushEdgesOppositeToVertex(T, TriangleIndex, SIndex, EdgeStack, &EdgeStackCount);
+	}
+
+	while(EdgeStackCount > 0)
+	{
+		// NOTE(hugo) : A flipped edge keeps its index, so an edge of the stack may have become one out of S
+		int EdgeIndex = EdgeStack[--EdgeStackCount];
+		edge E = T->Edges[EdgeIndex];
+		if(E.IsConstrained || (E.Vertex0Index == SIndex) || (E.Vertex1Index == SIndex))
+		{
+			continue;
+		}
+
+		int F0Index = 0;
+		int F1Index = 0;
+		bool GotTriangles = GetTrianglesOfEdge(T, EdgeIndex, &F0Index, &F1Index);
+		if(GotTriangles && !IsEdgeLocallyDelaunay(T, F0Index, F1Index))
+		{
+			PerformLawsonFlip(T, F0Index, F1Index);
+			PushEdgesOppositeToVertex(T, F0Index, SIndex, EdgeStack, &EdgeStackCount);
+			PushEdgesOppositeToVertex(T, F1Index, SIndex, EdgeStack, &EdgeStackCount);
+		}
+	}
+
+	return(SIndex);
+}
+
+/* ------------------------------
+ *     constrained edges 
+ * ------------------------------ */
+
+struct constraint_cavity
+{
+	// NOTE(hugo) : The triangles crossed by the constraint segment, and the edges it crosses
+	int TriangleIndices[2 * MAX_POINT_COUNT];
+	int TriangleCount;
+
+	int CrossedEdgeIndices[3 * MAX_POINT_COUNT];
+	int CrossedEdgeCount;
+	int FreeEdgeCount;
+
+	// NOTE(hugo) : The two pseudo-polygons on each side of the segment, ordered from A to B
+	int LeftVertexIndices[MAX_POINT_COUNT];
+	int LeftVertexCount;
+	int RightVertexIndices[MAX_POINT_COUNT];
+	int RightVertexCount;
+
+	// NOTE(hugo) : The boundary edges of the cavity and the edges created while retriangulating it
+	int EdgeIndices[3 * MAX_POINT_COUNT];
+	int EdgeCount;
+};
+
+template<typename kernel>
+int FindOrCreateCavityEdge(triangulation<kernel>* T, constraint_cavity* Cavity, int PIndex, int QIndex)
+{
+	for(int i = 0; i < Cavity->EdgeCount; ++i)
+	{
+		edge E = T->Edges[Cavity->EdgeIndices[i]];
+		if(((E.Vertex0Index == PIndex) && (E.Vertex1Index == QIndex))
+			||  ((E.Vertex0Index == QIndex) && (E.Vertex1Index == PIndex)))
+		{
+			return(Cavity->EdgeIndices[i]);
+		}
+	}
+
+	// NOTE(hugo) : The cavity has as many new edges to create as crossed edges that were removed,
+	// so we just reuse their slots.
+	Assert(Cavity->FreeEdgeCount > 0);
+	Cavity->FreeEdgeCount--;
+	int EdgeIndex = Cavity->CrossedEdgeIndices[Cavity->FreeEdgeCount];
+	edge* E = T->Edges + EdgeIndex;
+	Assert(E->TriangleIndices[0] == -1);
+	Assert(E->TriangleIndices[1] == -1);
+	E->Vertex0Index = PIndex;
+	E->Vertex1Index = QIndex;
+	E->IsConstrained = false;
+
+	Assert(Cavity->EdgeCount < ArrayCount(Cavity->EdgeIndices));
+	Cavity->EdgeIndices[Cavity->EdgeCount] = EdgeIndex;
+	Cavity->EdgeCount++;
+
+	return(EdgeIndex);
+}
+
+template<typename kernel>
+void TriangulatePseudoPolygon(triangulation<kernel>* T, constraint_cavity* Cavity, int AIndex, int BIndex, int* PolygonVertexIndices, int PolygonVertexCount)
+{
+	// NOTE(hugo) : The polygon is A, P0, ..., Pn-1, B. We look for the vertex C of the polygon so that no other
+	// vertex lies in the circle of ABC, then recurse on A, P0, ..., C and on C, ..., Pn-1, B.
+	if(PolygonVertexCount == 0)
+	{
+		return;
+	}
+
+	vertex<kernel> A = T->Vertices[AIndex];
+	vertex<kernel> B = T->Vertices[BIndex];
+	int CPolygonIndex = 0;
+	for(int PolygonIndex = 1; PolygonIndex < PolygonVertexCount; ++PolygonIndex)
+	{
+		vertex<kernel> C = T->Vertices[PolygonVertexIndices[CPolygonIndex]];
+		vertex<kernel> V = T->Vertices[PolygonVertexIndices[PolygonIndex]];
+		if(IsInCircumcircle(A, B, C, V))
+		{
+			CPolygonIndex = PolygonIndex;
+		}
+	}
+	int CIndex = PolygonVertexIndices[CPolygonIndex];
+
+	TriangulatePseudoPolygon(T, Cavity, AIndex, CIndex, PolygonVertexIndices, CPolygonIndex);
+	TriangulatePseudoPolygon(T, Cavity, CIndex, BIndex, PolygonVertexIndices + CPolygonIndex + 1, PolygonVertexCount - CPolygonIndex - 1);
+
+	int ABIndex = FindOrCreateCavityEdge(T, Cavity, AIndex, BIndex);
+	int ACIndex = FindOrCreateCavityEdge(T, Cavity, AIndex, CIndex);
+	int CBIndex = FindOrCreateCavityEdge(T, Cavity, CIndex, BIndex);
+	triangle F = {ABIndex, CBIndex, ACIndex, AIndex, BIndex, CIndex};
+	PushTriangle(T, F);
+}
+
+enum constraint_step_type
+{
+	ConstraintStep_AlongEdge,
+	ConstraintStep_Cavity,
+	ConstraintStep_Blocked,
+};
+
+struct constraint_step
+{
+	constraint_step_type Type;
+	// NOTE(hugo) : The vertex of AB where the step stops, B or a vertex lying on AB
+	int EndIndex;
+	// NOTE(hugo) : Only for ConstraintStep_AlongEdge
+	int AlongEdgeIndex;
+};
+
+template<typename kernel>
+int FindNextTriangleAroundVertex(triangulation<kernel>* T, int AIndex, int TriangleIndex, int PreviousTriangleIndex)
+{
+	// NOTE(hugo) : Goes through one of the two edges out of A of the triangle, not back to the previous triangle.
+	// Returns -1 on the border of the triangulation.
+	triangle F = T->Triangles[TriangleIndex];
+	for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
+	{
+		edge E = T->Edges[F.EdgeIndices[i]];
+		if((E.Vertex0Index == AIndex) || (E.Vertex1Index == AIndex))
+		{
+			int NextTriangleIndex = FindOtherTriangleOfEdge(T, F.EdgeIndices[i], TriangleIndex);
+			if(NextTriangleIndex != PreviousTriangleIndex)
+			{
+				return(NextTriangleIndex);
+			}
+		}
+	}
+
+	return(-1);
+}
+
+template<typename kernel>
+bool FindConstraintStartAroundVertex(triangulation<kernel>* T, int AIndex, int BIndex, int TriangleIndex, constraint_step* Step, int* StartTriangleIndex)
+{
+	// NOTE(hugo) : Returns true if this triangle around A either has an edge along AB or is crossed by AB
+	vertex<kernel> A = T->Vertices[AIndex];
+	vertex<kernel> B = T->Vertices[BIndex];
+	triangle F = T->Triangles[TriangleIndex];
+	int OtherVertexIndices[2];
+	int OtherVertexCount = 0;
+	for(int i = 0; i < ArrayCount(F.VertexIndices); ++i)
+	{
+		if(F.VertexIndices[i] != AIndex)
+		{
+			OtherVertexIndices[OtherVertexCount++] = F.VertexIndices[i];
+		}
+	}
+	Assert(OtherVertexCount == 2);
+
+	int PIndex = OtherVertexIndices[0];
+	int QIndex = OtherVertexIndices[1];
+	vertex<kernel> P = T->Vertices[PIndex];
+	vertex<kernel> Q = T->Vertices[QIndex];
+	int POrientation = Orientation(A, B, P);
+	int QOrientation = Orientation(A, B, Q);
+
+	// NOTE(hugo) : A vertex aligned with AB and in the direction of B is either B or a vertex lying on AB
+	if((POrientation == 0) && IsInDirection(A, B, P))
+	{
+		Step->Type = ConstraintStep_AlongEdge;
+		Step->AlongEdgeIndex = FindEdgeIndexLinkingVertices(T, AIndex, PIndex, F);
+		Step->EndIndex = PIndex;
+		return(true);
+	}
+	if((QOrientation == 0) && IsInDirection(A, B, Q))
+	{
+		Step->Type = ConstraintStep_AlongEdge;
+		Step->AlongEdgeIndex = FindEdgeIndexLinkingVertices(T, AIndex, QIndex, F);
+		Step->EndIndex = QIndex;
+		return(true);
+	}
+	if((POrientation * QOrientation < 0) && (Orientation(P, Q, A) * Orientation(P, Q, B) < 0))
+	{
+		*StartTriangleIndex = TriangleIndex;
+		return(true);
+	}
+
+	return(false);
+}
+
+template<typename kernel>
+constraint_step FindConstraintStep(triangulation<kernel>* T, int AIndex, int BIndex, constraint_cavity* Cavity)
+{
+	// NOTE(hugo) : Finds how the constraint goes on from A towards B, without touching the triangulation.
+	// Either along an existing edge, or through the triangles listed in the cavity up to B or to a vertex lying on AB.
+	constraint_step Step = {};
+	Step.Type = ConstraintStep_Blocked;
+	Step.EndIndex = -1;
+	Step.AlongEdgeIndex = -1;
+
+	// NOTE(hugo) : Turning around A from one of its triangles, the other way round if we hit the border
+	int StartTriangleIndex = -1;
+	int FirstTriangleIndex = T->VertexTriangleIndices[AIndex];
+	Assert(IsVertexInTriangle(T, AIndex, FirstTriangleIndex));
+	bool Found = false;
+	for(int Direction = 0; (Direction < 2) && !Found; ++Direction)
+	{
+		int PreviousTriangleIndex = -1;
+		int TriangleIndex = FirstTriangleIndex;
+		if(Direction == 1)
+		{
+			// NOTE(hugo) : The first triangle was already tested, we start from its other neighbour around A
+			PreviousTriangleIndex = FindNextTriangleAroundVertex(T, AIndex, FirstTriangleIndex, -1);
+			TriangleIndex = FindNextTriangleAroundVertex(T, AIndex, FirstTriangleIndex, PreviousTriangleIndex);
+			PreviousTriangleIndex = FirstTriangleIndex;
+		}
+		while((TriangleIndex != -1) && !Found)
+		{
+			Found = FindConstraintStartAroundVertex(T, AIndex, BIndex, TriangleIndex, &Step, &StartTriangleIndex);
+			int NextTriangleIndex = FindNextTriangleAroundVertex(T, AIndex, TriangleIndex, PreviousTriangleIndex);
+			PreviousTriangleIndex = TriangleIndex;
+			TriangleIndex = NextTriangleIndex;
+			if(TriangleIndex == FirstTriangleIndex)
+			{
+				// NOTE(hugo) : A full turn, there is no border to come back from
+				Direction = 2;
+				break;
+			}
+		}
+	}
+
+	if(Step.Type == ConstraintStep_AlongEdge)
+	{
+		return(Step);
+	}
+
+	if(StartTriangleIndex == -1)
+	{
+		SDL_Log("InsertConstraint : no triangle crossed around the first vertex.");
+		return(Step);
+	}
+
+	// NOTE(hugo) : Walking from A to B through the crossed triangles
+	vertex<kernel> A = T->Vertices[AIndex];
+	vertex<kernel> B = T->Vertices[BIndex];
+	Cavity->TriangleCount = 0;
+	Cavity->CrossedEdgeCount = 0;
+	Cavity->LeftVertexCount = 0;
+	Cavity->RightVertexCount = 0;
+	Cavity->EdgeCount = 0;
+
+	triangle StartTriangle = T->Triangles[StartTriangleIndex];
+	int LIndex = -1;
+	int RIndex = -1;
+	for(int i = 0; i < ArrayCount(StartTriangle.VertexIndices); ++i)
+	{
+		int VIndex = StartTriangle.VertexIndices[i];
+		if(VIndex != AIndex)
+		{
+			if(Orientation(A, B, T->Vertices[VIndex]) > 0)
+			{
+				LIndex = VIndex;
+			}
+			else
+			{
+				RIndex = VIndex;
+			}
+		}
+	}
+	Assert((LIndex != -1) && (RIndex != -1));
+	Cavity->LeftVertexIndices[Cavity->LeftVertexCount++] = LIndex;
+	Cavity->RightVertexIndices[Cavity->RightVertexCount++] = RIndex;
+	Cavity->TriangleIndices[Cavity->TriangleCount++] = StartTriangleIndex;
+
+	int CurrentTriangleIndex = StartTriangleIndex;
+	int CrossedEdgeIndex = FindEdgeIndexLinkingVertices(T, LIndex, RIndex, StartTriangle);
+	int EndIndex = -1;
+	while(EndIndex == -1)
+	{
+		if(T->Edges[CrossedEdgeIndex].IsConstrained)
+		{
+			SDL_Log("InsertConstraint : the segment crosses another constraint.");
+			return(Step);
+		}
+		Assert(Cavity->CrossedEdgeCount < ArrayCount(Cavity->CrossedEdgeIndices));
+		Cavity->CrossedEdgeIndices[Cavity->CrossedEdgeCount++] = CrossedEdgeIndex;
+
+		int NextTriangleIndex = FindOtherTriangleOfEdge(T, CrossedEdgeIndex, CurrentTriangleIndex);
+		Assert(NextTriangleIndex != -1);
+		Assert(Cavity->TriangleCount < ArrayCount(Cavity->TriangleIndices));
+		Cavity->TriangleIndices[Cavity->TriangleCount++] = NextTriangleIndex;
+
+		int VIndex = FindVertexIndexNotInEdgeInTriangle(T, CrossedEdgeIndex, NextTriangleIndex);
+		int VOrientation = Orientation(A, B, T->Vertices[VIndex]);
+		if((VIndex == BIndex) || (VOrientation == 0))
+		{
+			// NOTE(hugo) : Either we reached B or a vertex lying on AB. In the latter case we go on from there.
+			EndIndex = VIndex;
+		}
+		else if(VOrientation > 0)
+		{
+			Cavity->LeftVertexIndices[Cavity->LeftVertexCount++] = VIndex;
+			CrossedEdgeIndex = FindEdgeIndexLinkingVertices(T, VIndex, RIndex, T->Triangles[NextTriangleIndex]);
+			LIndex = VIndex;
+		}
+		else
+		{
+			Cavity->RightVertexIndices[Cavity->RightVertexCount++] = VIndex;
+			CrossedEdgeIndex = FindEdgeIndexLinkingVertices(T, LIndex, VIndex, T->Triangles[NextTriangleIndex]);
+			RIndex = VIndex;
+		}
+		CurrentTriangleIndex = NextTriangleIndex;
+	}
+
+	Step.Type = ConstraintStep_Cavity;
+	Step.EndIndex = EndIndex;
+	return(Step);
+}
+
+template<typename kernel>
+void RetriangulateConstraintCavity(triangulation<kernel>* T, constraint_cavity* Cavity, int AIndex, int EndIndex)
+{
+	// NOTE(hugo) : The edges of the crossed triangles that are not crossed are the boundary of the cavity.
+	// An edge of a crossed triangle is crossed exactly when its ends are strictly on both sides of AB.
+	vertex<kernel> A = T->Vertices[AIndex];
+	vertex<kernel> B = T->Vertices[EndIndex];
+	for(int CavityTriangleIndex = 0; CavityTriangleIndex < Cavity->TriangleCount; ++CavityTriangleIndex)
+	{
+		triangle F = T->Triangles[Cavity->TriangleIndices[CavityTriangleIndex]];
+		for(int i = 0; i < ArrayCount(F.EdgeIndices); ++i)
+		{
+			edge E = T->Edges[F.EdgeIndices[i]];
+			int Orientation0 = Orientation(A, B, T->Vertices[E.Vertex0Index]);
+			int Orientation1 = Orientation(A, B, T->Vertices[E.Vertex1Index]);
+			if(Orientation0 * Orientation1 >= 0)
+			{
+				Assert(Cavity->EdgeCount < ArrayCount(Cavity->EdgeIndices));
+				Cavity->EdgeIndices[Cavity->EdgeCount++] = F.EdgeIndices[i];
+			}
+		}
+	}
+
+	// NOTE(hugo) : Deleting the crossed triangles from the highest index to the lowest one
+	// so that the swap in DeleteTriangle never moves a triangle we still have to delete.
+	for(int i = 1; i < Cavity->TriangleCount; ++i)
+	{
+		int TriangleIndex = Cavity->TriangleIndices[i];
+		int j = i;
+		while((j > 0) && (Cavity->TriangleIndices[j - 1] < TriangleIndex))
+		{
+			Cavity->TriangleIndices[j] = Cavity->TriangleIndices[j - 1];
+			--j;
+		}
+		Cavity->TriangleIndices[j] = TriangleIndex;
+	}
+	for(int i = 0; i < Cavity->TriangleCount; ++i)
+	{
+		DeleteTriangle(T, Cavity->TriangleIndices[i]);
+	}
+
+	Cavity->FreeEdgeCount = Cavity->CrossedEdgeCount;
+	int ConstraintEdgeIndex = FindOrCreateCavityEdge(T, Cavity, AIndex, EndIndex);
+	T->Edges[ConstraintEdgeIndex].IsConstrained = true;
+
+	TriangulatePseudoPolygon(T, Cavity, AIndex, EndIndex, Cavity->LeftVertexIndices, Cavity->LeftVertexCount);
+	TriangulatePseudoPolygon(T, Cavity, AIndex, EndIndex, Cavity->RightVertexIndices, Cavity->RightVertexCount);
+	Assert(Cavity->FreeEdgeCount == 0);
+}
+
+template<typename kernel>
+bool InsertConstraint(triangulation<kernel>* T, int AIndex, int BIndex)
+{
+	// NOTE(hugo) : Forces the segment AB into the triangulation. The triangles crossed by AB are removed
+	// and the two pseudo-polygons on each side are retriangulated. The start is found by turning around A,
+	// so the cost only depends on the degree of the vertices on AB and on the number of crossed triangles.
+	// AB is split at the vertices lying on it. The whole segment is checked before anything is changed :
+	// if any part of AB crosses another constraint, false is returned and T is left untouched.
+	Assert(AIndex != BIndex);
+	Assert(T->Vertices[AIndex].IsRealPoint);
+	Assert(T->Vertices[BIndex].IsRealPoint);
+	// NOTE(hugo) : The cavity arrays are sized for MAX_POINT_COUNT vertices
+	Assert(T->VertexCount <= MAX_POINT_COUNT);
+
+	constraint_cavity Cavity;
+	for(int StepAIndex = AIndex; StepAIndex != BIndex;)
+	{
+		constraint_step Step = FindConstraintStep(T, StepAIndex, BIndex, &Cavity);
+		if(Step.Type == ConstraintStep_Blocked)
+		{
+			return(false);
+		}
+		StepAIndex = Step.EndIndex;
+	}
+
+	// NOTE(hugo) : Retriangulating a cavity only changes the triangles crossed by its own part of AB,
+	// so the parts still to come stay as they were checked.
+	while(AIndex != BIndex)
+	{
+		constraint_step Step = FindConstraintStep(T, AIndex, BIndex, &Cavity);
+		Assert(Step.Type != ConstraintStep_Blocked);
+		if(Step.Type == ConstraintStep_AlongEdge)
+		{
+			T->Edges[Step.AlongEdgeIndex].IsConstrained = true;
+		}
+		else
+		{
+			RetriangulateConstraintCavity(T, &Cavity, AIndex, Step.EndIndex);
+		}
+		AIndex = Step.EndIndex;
+	}
+
+	return(true);
+}
+
+template<typename kernel>
+int FindClosestRealVertex(triangulation<kernel>* T, typename kernel::coord x, typename kernel::coord y)
+{
+	typedef typename kernel::real real;
+
+	int ClosestVertexIndex = -1;
+	real ClosestSquaredDistance = 0;
+	for(int VertexIndex = 0; VertexIndex < T->VertexCount; ++VertexIndex)
+	{
+		vertex<kernel> V = T->Vertices[VertexIndex];
+		if(V.IsRealPoint)
+		{
+			real DeltaX = real(V.x) - real(x);
+			real DeltaY = real(V.y) - real(y);
+			real SquaredDistance = DeltaX * DeltaX + DeltaY * DeltaY;
+			if((ClosestVertexIndex == -1) || (SquaredDistance < ClosestSquaredDistance))
+			{
+				ClosestVertexIndex = VertexIndex;
+				ClosestSquaredDistance = SquaredDistance;
+			}
+		}
+	}
+
+	return(ClosestVertexIndex);
+}
+
+/* ------------------------------
+ *          work queue
+ * ------------------------------ */
+
+// NOTE(hugo) : Fork / join : entries are added to the queue, then CompleteAllWork runs them on
+// ThreadCount threads (the calling one included) and only returns once they are all done.
+// The worker threads are started the first time they are needed and then wait on their own
+// semaphore between two calls, so a call only costs a wake up per thread. CompleteAllWork must
+// always be called from the same thread, and never from a callback.
+
+#define MAX_THREAD_COUNT 64
+
+typedef void work_queue_callback(int ThreadIndex, void* Data);
+
+struct work_queue_entry
+{
+	work_queue_callback* Callback;
+	void* Data;
+};
+
+struct work_queue
+{
+	work_queue_entry Entries[1024];
+	int EntryCount;
+	SDL_atomic_t NextEntryToDo;
+};
+
+struct work_thread_context
+{
+	// NOTE(hugo) : Queue is written before WakeSemaphore is posted, the post publishes it
+	work_queue* Queue;
+	int ThreadIndex;
+	SDL_sem* WakeSemaphore;
+};
+
+struct work_thread_pool
+{
+	// NOTE(hugo) : Context i is for the thread that runs as ThreadIndex i, 0 is the calling thread and has none
+	work_thread_context Contexts[MAX_THREAD_COUNT];
+	int StartedThreadCount;
+	SDL_sem* DoneSemaphore;
+};
+
+static work_thread_pool WorkThreadPool;
+
+int GetWorkerThreadCount()
+{
+	int ThreadCount = SDL_GetCPUCount();
+	if(ThreadCount < 1)
+	{
+		ThreadCount = 1;
+	}
+	if(ThreadCount > MAX_THREAD_COUNT)
+	{
+		ThreadCount = MAX_THREAD_COUNT;
+	}
+
+	return(ThreadCount);
+}
+
+void AddWorkEntry(work_queue* Queue, work_queue_callback* Callback, void* Data)
+{
+	Assert(Queue->EntryCount < ArrayCount(Queue->Entries));
+	work_queue_entry* Entry = Queue->Entries + Queue->EntryCount;
+	Entry->Callback = Callback;
+	Entry->Data = Data;
+	Queue->EntryCount++;
+}
+
+void DoWork(work_queue* Queue, int ThreadIndex)
+{
+	for(;;)
+	{
+		int EntryIndex = SDL_AtomicAdd(&Queue->NextEntryToDo, 1);
+		if(EntryIndex >= Queue->EntryCount)
+		{
+			break;
+		}
+		work_queue_entry Entry = Queue->Entries[EntryIndex];
+		Entry.Callback(ThreadIndex, Entry.Data);
+	}
+}
+
+int WorkThreadProc(void* Data)
+{
+	work_thread_context* Context = (work_thread_context*)Data;
+	for(;;)
+	{
+		SDL_SemWait(Context->WakeSemaphore);
+		DoWork(Context->Queue, Context->ThreadIndex);
+		SDL_SemPost(WorkThreadPool.DoneSemaphore);
+	}
+
+	return(0);
+}
+
+void StartWorkThreads(int ThreadCount)
+{
+	// NOTE(hugo) : The pool only grows, the threads live as long as the program
+	work_thread_pool* Pool = &WorkThreadPool;
+	if(!Pool->DoneSemaphore)
+	{
+		Pool->DoneSemaphore = SDL_CreateSemaphore(0);
+		Assert(Pool->DoneSemaphore);
+		Pool->StartedThreadCount = 1;
+	}
+	for(int ThreadIndex = Pool->StartedThreadCount; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		work_thread_context* Context = Pool->Contexts + ThreadIndex;
+		Context->Queue = 0;
+		Context->ThreadIndex = ThreadIndex;
+		Context->WakeSemaphore = SDL_CreateSemaphore(0);
+		Assert(Context->WakeSemaphore);
+		SDL_Thread* Thread = SDL_CreateThread(WorkThreadProc, "delone worker", Context);
+		Assert(Thread);
+		SDL_DetachThread(Thread);
+		Pool->StartedThreadCount++;
+	}
+}
+
+void CompleteAllWork(work_queue* Queue, int ThreadCount)
+{
+	if(ThreadCount > Queue->EntryCount)
+	{
+		ThreadCount = Queue->EntryCount;
+	}
+	if(ThreadCount > MAX_THREAD_COUNT)
+	{
+		ThreadCount = MAX_THREAD_COUNT;
+	}
+
+	SDL_AtomicSet(&Queue->NextEntryToDo, 0);
+	StartWorkThreads(ThreadCount);
+	work_thread_pool* Pool = &WorkThreadPool;
+	for(int ThreadIndex = 1; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		Pool->Contexts[ThreadIndex].Queue = Queue;
+		SDL_SemPost(Pool->Contexts[ThreadIndex].WakeSemaphore);
+	}
+
+	DoWork(Queue, 0);
+
+	for(int ThreadIndex = 1; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		SDL_SemWait(Pool->DoneSemaphore);
+	}
+	Queue->EntryCount = 0;
+}
+
+#include "delone_sort.cpp"
+#include "delone_mesh.cpp"
+#include "delone_proximity.cpp"
+#include "delone_raster.cpp"
+#include "delone_tetra.cpp"
+#include "delone_batch.cpp"
+
+/* ------------------------------
+ *     input recording / replay
+ * ------------------------------ */
+
+// NOTE(hugo) : Every input that changes the triangulation goes through ProcessInput, either
+// from the window or from a recording, so a recorded session can be replayed exactly without a window.
+
+enum input_type
+{
+	Input_Point,
+	Input_ConstraintClick,
+};
+
+struct recorded_input
+{
+	// NOTE(hugo) : Milliseconds since SDL was initialized, coordinates are already in triangulation space
+	uint32_t Timestamp;
+	input_type Type;
+	int x;
+	int y;
+};
+
+struct delone_state
+{
+	triangulation<screen_kernel> Triangulation;
+	triangulation_storage<screen_kernel> TriangulationStorage;
+
+	// NOTE(hugo) : A constraint is entered with two right clicks, each one picking the closest vertex
+	int ConstraintFirstVertexIndex;
+};
+
+void InitScreenTriangulation(triangulation<screen_kernel>* T)
+{
+	int FarAwayCoordinate = 8000;
+	vertex<screen_kernel> FakePoint0 = {-100, ScreenHeight - (-FarAwayCoordinate), false};
+	vertex<screen_kernel> FakePoint1 = {-100, ScreenHeight - FarAwayCoordinate, false};
+	vertex<screen_kernel> FakePoint2 = {FarAwayCoordinate, ScreenHeight - FarAwayCoordinate, false};
+	InitTriangulation(T, FakePoint0, FakePoint1, FakePoint2);
+}
+
+void ProcessInput(delone_state* State, recorded_input Input, SDL_Renderer* Renderer, TTF_Font* Font)
+{
+	triangulation<screen_kernel>* T = &State->Triangulation;
+	switch(Input.Type)
+	{
+		case Input_Point:
+			{
+				// NOTE(hugo) : Recordings are replayed through ComputeDelaunay, the path they were recorded with
+				vertex<screen_kernel> V = {Input.x, Input.y, true};
+				if(T->VertexCount == T->MaxVertexCount)
+				{
+					SDL_Log("Ignoring the point (%i, %i), the triangulation is full.", Input.x, Input.y);
+				}
+				else
+				{
+					PushVertex(T, V);
+					if(!ComputeDelaunay(T, Renderer, Font))
+					{
+						SDL_Log("Ignoring the point (%i, %i), it lies on an edge or on a vertex.", Input.x, Input.y);
+					}
+				}
+			} break;
+		case Input_ConstraintClick:
+			{
+				int VertexIndex = FindClosestRealVertex(T, Input.x, Input.y);
+				if((State->ConstraintFirstVertexIndex == -1) || (VertexIndex == State->ConstraintFirstVertexIndex))
+				{
+					State->ConstraintFirstVertexIndex = VertexIndex;
+				}
+				else if(VertexIndex != -1)
+				{
+					if(!InsertConstraint(T, State->ConstraintFirstVertexIndex, VertexIndex))
+					{
+						SDL_Log("Could not insert the constraint %i - %i.", State->ConstraintFirstVertexIndex, VertexIndex);
+					}
+					Assert(IsTriangulationValid(T));
+					State->ConstraintFirstVertexIndex = -1;
+				}
+			} break;
+	}
+}
+
+void WriteInput(FILE* File, recorded_input Input)
+{
+	char TypeCharacter = (Input.Type == Input_Point) ? 'P' : 'C';
+	fprintf(File, "%c %u %d %d\n", TypeCharacter, Input.Timestamp, Input.x, Input.y);
+	// NOTE(hugo) : Flushing every input, the sequences we want to keep are the ones that end up crashing
+	fflush(File);
+}
+
+bool ReadInput(FILE* File, recorded_input* Input)
+{
+	char TypeCharacter = 0;
+	if(fscanf(File, " %c %u %d %d", &TypeCharacter, &Input->Timestamp, &Input->x, &Input->y) != 4)
+	{
+		return(false);
+	}
+
+	if(TypeCharacter == 'P')
+	{
+		Input->Type = Input_Point;
+	}
+	else if(TypeCharacter == 'C')
+	{
+		Input->Type = Input_ConstraintClick;
+	}
+	else
+	{
+		return(false);
+	}
+
+	return(true);
+}
+
+uint32_t GetPercentile(sort_entry* SortedEntries, int Count, int Percent)
+{
+	Assert(Count > 0);
+	int Index = ((Count - 1) * Percent) / 100;
+
+	return((uint32_t)SortedEntries[Index].SortKey);
+}
+
+void PrintLatencies(const char* Name, sort_entry* Latencies, int Count)
+{
+	if(Count == 0)
+	{
+		printf("%-12s : none\n", Name);
+		return;
+	}
+
+	sort_entry* SortTemp = (sort_entry*)malloc(Count * sizeof(sort_entry));
+	if(!SortTemp)
+	{
+		printf("%-12s : could not allocate the sort of %i latencies\n", Name, Count);
+		return;
+	}
+	MergeSort(Count, Latencies, SortTemp);
+	free(SortTemp);
+	printf("%-12s : %4i, p50 %6u us, p90 %6u us, p99 %6u us, max %6u us\n", Name, Count,
+			GetPercentile(Latencies, Count, 50), GetPercentile(Latencies, Count, 90),
+			GetPercentile(Latencies, Count, 99), (uint32_t)Latencies[Count - 1].SortKey);
+}
+
+int ReplayRecording(char* Path, char* ExpectedHashString)
+{
+	// NOTE(hugo) : Headless, as fast as possible : the timestamps are only kept for reference
+	FILE* File = fopen(Path, "r");
+	if(!File)
+	{
+		printf("Could not open the recording %s.\n", Path);
+		return(1);
+	}
+
+	// NOTE(hugo) : A first pass counts the inputs, so that every latency is kept however long the recording is
+	int RecordedPointCount = 0;
+	int RecordedConstraintCount = 0;
+	recorded_input Input;
+	while(ReadInput(File, &Input))
+	{
+		if(Input.Type == Input_Point)
+		{
+			RecordedPointCount++;
+		}
+		else
+		{
+			RecordedConstraintCount++;
+		}
+	}
+	rewind(File);
+
+	sort_entry* PointLatencies = (sort_entry*)malloc((RecordedPointCount + 1) * sizeof(sort_entry));
+	sort_entry* ConstraintLatencies = (sort_entry*)malloc((RecordedConstraintCount + 1) * sizeof(sort_entry));
+	if(!PointLatencies || !ConstraintLatencies)
+	{
+		printf("Could not allocate the latencies of %i inputs.\n", RecordedPointCount + RecordedConstraintCount);
+		free(PointLatencies);
+		free(ConstraintLatencies);
+		fclose(File);
+		return(1);
+	}
+
+	delone_state State = {};
+	AttachTriangulationStorage(&State.Triangulation, &State.TriangulationStorage);
+	InitScreenTriangulation(&State.Triangulation);
+	State.ConstraintFirstVertexIndex = -1;
+
+	int PointCount = 0;
+	int ConstraintCount = 0;
+	uint64_t CounterFrequency = SDL_GetPerformanceFrequency();
+
+	while(ReadInput(File, &Input))
+	{
+		uint64_t Start = SDL_GetPerformanceCounter();
+		ProcessInput(&State, Input, 0, 0);
+		uint64_t End = SDL_GetPerformanceCounter();
+
+		uint32_t Microseconds = (uint32_t)(((End - Start) * 1000000) / CounterFrequency);
+		// NOTE(hugo) : Rejected clicks are timed too
+		sort_entry* Latency = 0;
+		if(Input.Type == Input_Point)
+		{
+			Assert(PointCount < RecordedPointCount);
+			Latency = PointLatencies + PointCount++;
+		}
+		else
+		{
+			Assert(ConstraintCount < RecordedConstraintCount);
+			Latency = ConstraintLatencies + ConstraintCount++;
+		}
+		Latency->SortKey = Microseconds;
+		Latency->Index = PointCount + ConstraintCount - 1;
+	}
+	fclose(File);
+
+	printf("Replay of %s\n", Path);
+	PrintLatencies("points", PointLatencies, PointCount);
+	PrintLatencies("constraints", ConstraintLatencies, ConstraintCount);
+	free(PointLatencies);
+	free(ConstraintLatencies);
+
+	static compact_mesh<screen_kernel> Mesh;
+	static triangulation_storage<screen_kernel> HullScratchStorage;
+	triangulation<screen_kernel> HullScratch;
+	AttachTriangulationStorage(&HullScratch, &HullScratchStorage);
+	FinalizeTriangulation(&State.Triangulation, &Mesh, &HullScratch);
+	uint64_t Hash = HashCompactMesh(&Mesh);
+	printf("mesh         : %i vertices, %i triangles, hash %016llx\n", Mesh.VertexCount, Mesh.TriangleCount, (unsigned long long)Hash);
+
+	if(ExpectedHashString)
+	{
+		uint64_t ExpectedHash = strtoull(ExpectedHashString, 0, 16);
+		if(Hash != ExpectedHash)
+		{
+			printf("Hash mismatch : expected %016llx\n", (unsigned long long)ExpectedHash);
+			return(1);
+		}
+	}
+
+	return(0);
+}
+
+bool IsTriangleListDelaunay(int32_t* Positions, int PointCount, int DistinctPointCount, int* Triangles, int TriangleCount)
+{
+	// NOTE(hugo) : Brute force with the exact int32 predicates : counter clockwise triangles with empty circumcircles,
+	// no directed edge twice, no point on the outer side of a boundary edge (so the boundary is the convex hull),
+	// and as many triangles as a triangulation of the distinct points with this many hull edges
+	int BoundaryEdgeCount = 0;
+	for(int TriangleIndex = 0; TriangleIndex < TriangleCount; ++TriangleIndex)
+	{
+		vertex<kernel_i32> Corners[3] = {};
+		for(int i = 0; i < 3; ++i)
+		{
+			int PointIndex = Triangles[3 * TriangleIndex + i];
+			Corners[i].x = Positions[2 * PointIndex + 0];
+			Corners[i].y = Positions[2 * PointIndex + 1];
+			Corners[i].IsRealPoint = true;
+		}
+		if(!IsCounterClockWise(Corners[0], Corners[1], Corners[2]))
+		{
+			return(false);
+		}
+		for(int PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+		{
+			vertex<kernel_i32> V = {Positions[2 * PointIndex + 0], Positions[2 * PointIndex + 1], true};
+			if(IsInCircumcircle(Corners[0], Corners[1], Corners[2], V))
+			{
+				return(false);
+			}
+		}
+
+		for(int i = 0; i < 3; ++i)
+		{
+			int A = Triangles[3 * TriangleIndex + i];
+			int B = Triangles[3 * TriangleIndex + (i + 1) % 3];
+			bool HasTwin = false;
+			for(int OtherIndex = 0; OtherIndex < TriangleCount; ++OtherIndex)
+			{
+				for(int j = 0; j < 3; ++j)
+				{
+					int C = Triangles[3 * OtherIndex + j];
+					int D = Triangles[3 * OtherIndex + (j + 1) % 3];
+					if((OtherIndex != TriangleIndex) && (C == A) && (D == B))
+					{
+						return(false);
+					}
+					HasTwin = HasTwin || ((C == B) && (D == A));
+				}
+			}
+			if(!HasTwin)
+			{
+				BoundaryEdgeCount++;
+				for(int PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+				{
+					vertex<kernel_i32> V = {Positions[2 * PointIndex + 0], Positions[2 * PointIndex + 1], true};
+					if(Orientation(Corners[i], Corners[(i + 1) % 3], V) < 0)
+					{
+						return(false);
+					}
+				}
+			}
+		}
+	}
+
+	return((TriangleCount > 0) && (TriangleCount == 2 * DistinctPointCount - 2 - BoundaryEdgeCount));
+}
+
+template<typename kernel>
+bool CheckKernelTriangulation(const char* KernelName, const char* SetName, int PointCount, int32_t* Points,
+		typename kernel::coord Offset, typename kernel::coord Scale, const char* TransformName)
+{
+	// NOTE(hugo) : The kernel triangulates Offset + Scale * Points. Orient2D and InCircle keep their sign under a
+	// translation and a positive scaling, so the result is checked on Points with the int32 predicates, which share
+	// nothing with the arithmetic of the kernel being checked.
+	typedef typename kernel::coord coord;
+	static triangulation_storage<kernel> TStorage;
+	static triangulation_storage<kernel> HullScratchStorage;
+	triangulation<kernel> T;
+	triangulation<kernel> HullScratch;
+	AttachTriangulationStorage(&T, &TStorage);
+	AttachTriangulationStorage(&HullScratch, &HullScratchStorage);
+	static compact_mesh<kernel> Mesh;
+	static int SourcePointIndices[MAX_POINT_COUNT];
+	static int Triangles[3 * 2 * MAX_POINT_COUNT];
+	Assert(PointCount <= MAX_POINT_COUNT - 3);
+
+	int32_t Min = Points[0];
+	int32_t Max = Points[0];
+	for(int i = 0; i < 2 * PointCount; ++i)
+	{
+		Min = (Points[i] < Min) ? Points[i] : Min;
+		Max = (Points[i] > Max) ? Points[i] : Max;
+	}
+	InitTriangulationWithSuperTriangle(&T, Offset + Scale * coord(Min), Offset + Scale * coord(Max));
+	bool InRange = true;
+	for(int VertexIndex = 0; VertexIndex < T.VertexCount; ++VertexIndex)
+	{
+		InRange = InRange && kernel::IsInRange(T.Vertices[VertexIndex].x) && kernel::IsInRange(T.Vertices[VertexIndex].y);
+	}
+
+	int DistinctPointCount = 0;
+	for(int PointIndex = 0; InRange && (PointIndex < PointCount); ++PointIndex)
+	{
+		vertex<kernel> V = {Offset + Scale * coord(Points[2 * PointIndex + 0]), Offset + Scale * coord(Points[2 * PointIndex + 1]), true};
+		int VertexIndex = InsertVertex(&T, V);
+		if(VertexIndex != -1)
+		{
+			SourcePointIndices[VertexIndex] = PointIndex;
+			DistinctPointCount++;
+		}
+	}
+	FinalizeTriangulation(&T, &Mesh, &HullScratch);
+
+	for(int i = 0; i < 3 * Mesh.TriangleCount; ++i)
+	{
+		Triangles[i] = SourcePointIndices[Mesh.SourceVertexIndices[Mesh.TriangleVertexIndices[i]]];
+	}
+	bool Valid = InRange && (Mesh.VertexCount == DistinctPointCount)
+		&& IsTriangleListDelaunay(Points, PointCount, DistinctPointCount, Triangles, Mesh.TriangleCount);
+	printf("%-4s %-12s %-14s : %4i points, %4i triangles, %s\n", KernelName, SetName, TransformName,
+			DistinctPointCount, Mesh.TriangleCount, Valid ? "ok" : "NOT DELAUNAY");
+
+	return(Valid);
+}
+
+int ReferenceOrient3D(int64_t* a, int64_t* b, int64_t* c, int64_t* d)
+{
+	// NOTE(hugo) : Same determinant as FilteredOrient3D, exact in an int128 for coordinates below 2^20
+	int128 ADX = a[0] - d[0], ADY = a[1] - d[1], ADZ = a[2] - d[2];
+	int128 BDX = b[0] - d[0], BDY = b[1] - d[1], BDZ = b[2] - d[2];
+	int128 CDX = c[0] - d[0], CDY = c[1] - d[1], CDZ = c[2] - d[2];
+	int128 Determinant = ADZ * (BDX * CDY - CDX * BDY) + BDZ * (CDX * ADY - ADX * CDY) + CDZ * (ADX * BDY - BDX * ADY);
+
+	return(Sign(Determinant));
+}
+
+int ReferenceInSphere(int64_t* a, int64_t* b, int64_t* c, int64_t* d, int64_t* e)
+{
+	// NOTE(hugo) : Same determinant as FilteredInSphere, exact in an int128 for coordinates below 2^20
+	int128 AEX = a[0] - e[0], AEY = a[1] - e[1], AEZ = a[2] - e[2];
+	int128 BEX = b[0] - e[0], BEY = b[1] - e[1], BEZ = b[2] - e[2];
+	int128 CEX = c[0] - e[0], CEY = c[1] - e[1], CEZ = c[2] - e[2];
+	int128 DEX = d[0] - e[0], DEY = d[1] - e[1], DEZ = d[2] - e[2];
+	int128 AB = AEX * BEY - BEX * AEY;
+	int128 BC = BEX * CEY - CEX * BEY;
+	int128 CD = CEX * DEY - DEX * CEY;
+	int128 DA = DEX * AEY - AEX * DEY;
+	int128 AC = AEX * CEY - CEX * AEY;
+	int128 BD = BEX * DEY - DEX * BEY;
+	int128 ABC = AEZ * BC - BEZ * AC + CEZ * AB;
+	int128 BCD = BEZ * CD - CEZ * BD + DEZ * BC;
+	int128 CDA = CEZ * DA + DEZ * AC + AEZ * CD;
+	int128 DAB = DEZ * AB + AEZ * BD + BEZ * DA;
+	int128 ALift = AEX * AEX + AEY * AEY + AEZ * AEZ;
+	int128 BLift = BEX * BEX + BEY * BEY + BEZ * BEZ;
+	int128 CLift = CEX * CEX + CEY * CEY + CEZ * CEZ;
+	int128 DLift = DEX * DEX + DEY * DEY + DEZ * DEZ;
+	int128 Determinant = (DLift * ABC - CLift * DAB) + (BLift * CDA - ALift * BCD);
+
+	return(Sign(Determinant));
+}
+
+int64_t RandomCoordinate(uint32_t* RandomState, int BitCount)
+{
+	// NOTE(hugo) : Uniform in ]-2^BitCount, 2^BitCount[
+	uint64_t Bits = ((uint64_t)XorShift32(RandomState) << 32) | XorShift32(RandomState);
+	int64_t Magnitude = (int64_t)(Bits & ((uint64_t(1) << BitCount) - 1));
+
+	return((Bits >> 63) ? -Magnitude : Magnitude);
+}
+
+bool CheckExactPredicates(int32_t* CirclePoints, int CirclePointCount)
+{
+	// NOTE(hugo) : The exact expansion predicates against integer ones, and the int128 predicates of kernel_i64 against
+	// the expansions. Half the cases are random, the other half are degenerate (aligned, cocircular, coplanar, cospherical)
+	// far from the origin, or one unit away from it, which is where the floating point filters hand over to them.
+	static double InSphereScratch[IN_SPHERE_SCRATCH_COUNT];
+	uint32_t RandomState = 0x9E3779B9;
+	int TestCount = 20000;
+	int Mismatches[5] = {};
+
+	// NOTE(hugo) : Points on a sphere of radius 105 centered on the origin
+	static int64_t SpherePoints[3 * 4096];
+	int SpherePointCount = 0;
+	int64_t SphereRadius = 105;
+	for(int64_t x = -SphereRadius; x <= SphereRadius; ++x)
+	{
+		for(int64_t y = -SphereRadius; y <= SphereRadius; ++y)
+		{
+			int64_t ZSquare = SphereRadius * SphereRadius - x * x - y * y;
+			int64_t z = (ZSquare >= 0) ? (int64_t)sqrt((double)ZSquare) : -1;
+			if((z >= 0) && (z * z == ZSquare) && (SpherePointCount < ArrayCount(SpherePoints) / 3 - 1))
+			{
+				SpherePoints[3 * SpherePointCount + 0] = x;
+				SpherePoints[3 * SpherePointCount + 1] = y;
+				SpherePoints[3 * SpherePointCount + 2] = z;
+				SpherePointCount++;
+			}
+		}
+	}
+
+	for(int TestIndex = 0; TestIndex < TestCount; ++TestIndex)
+	{
+		bool Degenerate = (TestIndex & 1);
+		int64_t Delta[3];
+		int64_t Offset[3];
+		for(int Axis = 0; Axis < 3; ++Axis)
+		{
+			Delta[Axis] = (TestIndex & 2) ? ((int64_t)(XorShift32(&RandomState) % 3) - 1) : 0;
+			Offset[Axis] = RandomCoordinate(&RandomState, 26);
+		}
+		int64_t Steps[2] = {(int64_t)(XorShift32(&RandomState) % 16) - 8, (int64_t)(XorShift32(&RandomState) % 16) - 8};
+
+		// NOTE(hugo) : 2D, int32 coordinates below 2^28. A degenerate C is on the line AB, a degenerate D on the circle ABC.
+		vertex<kernel_i32> P[4] = {};
+		for(int i = 0; i < 4; ++i)
+		{
+			int32_t* CirclePoint = CirclePoints + 2 * (XorShift32(&RandomState) % CirclePointCount);
+			P[i].x = (int32_t)(Degenerate ? (Offset[0] + CirclePoint[0]) : RandomCoordinate(&RandomState, 27));
+			P[i].y = (int32_t)(Degenerate ? (Offset[1] + CirclePoint[1]) : RandomCoordinate(&RandomState, 27));
+			P[i].IsRealPoint = true;
+		}
+		P[3].x = (int32_t)(P[3].x + Delta[0]);
+		P[3].y = (int32_t)(P[3].y + Delta[1]);
+		Mismatches[1] += (ExactInCircle(P[0].x, P[0].y, P[1].x, P[1].y, P[2].x, P[2].y, P[3].x, P[3].y)
+				!= kernel_i32::InCircle(P[0], P[1], P[2], P[3]));
+		if(Degenerate)
+		{
+			P[2].x = (int32_t)(P[0].x + Steps[0] * (P[1].x - P[0].x) + Delta[0]);
+			P[2].y = (int32_t)(P[0].y + Steps[0] * (P[1].y - P[0].y) + Delta[1]);
+		}
+		Mismatches[0] += (ExactOrient2D(P[0].x, P[0].y, P[1].x, P[1].y, P[2].x, P[2].y) != kernel_i32::Orient2D(P[0], P[1], P[2]));
+
+		// NOTE(hugo) : kernel_i64 int128 orientation against the expansion, coordinates below 2^52
+		vertex<kernel_i64> Q[3] = {};
+		for(int i = 0; i < 3; ++i)
+		{
+			Q[i].x = RandomCoordinate(&RandomState, 51);
+			Q[i].y = RandomCoordinate(&RandomState, 51);
+			Q[i].IsRealPoint = true;
+		}
+		if(Degenerate)
+		{
+			Q[1].x = Q[0].x + (Q[1].x >> 4);
+			Q[1].y = Q[0].y + (Q[1].y >> 4);
+			Q[2].x = Q[0].x + Steps[0] * (Q[1].x - Q[0].x) + Delta[0];
+			Q[2].y = Q[0].y + Steps[0] * (Q[1].y - Q[0].y) + Delta[1];
+		}
+		Mismatches[2] += (kernel_i64::Orient2D(Q[0], Q[1], Q[2]) != ExactOrient2D(double(Q[0].x), double(Q[0].y),
+					double(Q[1].x), double(Q[1].y), double(Q[2].x), double(Q[2].y)));
+
+		// NOTE(hugo) : 3D, coordinates below 2^20. A degenerate D is on the plane ABC, degenerate ABCDE are on a sphere.
+		int64_t Points3[5][3];
+		double Doubles3[5][3];
+		for(int i = 0; i < 5; ++i)
+		{
+			int64_t* SpherePoint = SpherePoints + 3 * (XorShift32(&RandomState) % SpherePointCount);
+			for(int Axis = 0; Axis < 3; ++Axis)
+			{
+				Points3[i][Axis] = Degenerate ? ((Offset[Axis] >> 7) + SpherePoint[Axis]) : RandomCoordinate(&RandomState, 19);
+				Points3[i][Axis] += (i == 4) ? Delta[Axis] : 0;
+				Doubles3[i][Axis] = (double)Points3[i][Axis];
+			}
+		}
+		Mismatches[4] += (ExactInSphere(Doubles3[0], Doubles3[1], Doubles3[2], Doubles3[3], Doubles3[4], InSphereScratch)
+				!= ReferenceInSphere(Points3[0], Points3[1], Points3[2], Points3[3], Points3[4]));
+		if(Degenerate)
+		{
+			for(int Axis = 0; Axis < 3; ++Axis)
+			{
+				Points3[3][Axis] = Points3[0][Axis] + Steps[0] * (Points3[1][Axis] - Points3[0][Axis])
+					+ Steps[1] * (Points3[2][Axis] - Points3[0][Axis]) + Delta[Axis];
+				Doubles3[3][Axis] = (double)Points3[3][Axis];
+			}
+		}
+		Mismatches[3] += (ExactOrient3D(Doubles3[0], Doubles3[1], Doubles3[2], Doubles3[3]) != ReferenceOrient3D(Points3[0], Points3[1], Points3[2], Points3[3]));
+	}
+
+	const char* Names[5] = {"orient2d", "incircle", "i64 orient2d", "orient3d", "insphere"};
+	bool Valid = true;
+	for(int i = 0; i < 5; ++i)
+	{
+		printf("%-12s : %i cases, %i mismatches\n", Names[i], TestCount, Mismatches[i]);
+		Valid = Valid && (Mismatches[i] == 0);
+	}
+
+	return(Valid);
+}
+
+int RunKernelCheck()
+{
+	// NOTE(hugo) : The predicates on their own, then every kernel triangulating random points, a grid (aligned
+	// and cocircular everywhere), the integer points of a circle and points rounded next to a long line, with
+	// coordinates large enough or close enough to each other to go through the int128 and exact expansion paths
+	static int32_t Points[4][2 * MAX_POINT_COUNT];
+	const char* SetNames[4] = {"random", "grid", "circle", "near line"};
+	int PointCounts[4] = {};
+
+	uint32_t RandomState = 0x9E3779B9;
+	for(int PointIndex = 0; PointIndex < 400; ++PointIndex)
+	{
+		Points[0][2 * PointIndex + 0] = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+		Points[0][2 * PointIndex + 1] = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+	}
+	PointCounts[0] = 400;
+
+	for(int PointIndex = 0; PointIndex < 20 * 20; ++PointIndex)
+	{
+		Points[1][2 * PointIndex + 0] = PointIndex % 20;
+		Points[1][2 * PointIndex + 1] = PointIndex / 20;
+	}
+	PointCounts[1] = 20 * 20;
+
+	// NOTE(hugo) : 5525 = 5^2 * 13 * 17 has a lot of ways to be the sum of two squares
+	int64_t Radius = 5525;
+	for(int64_t x = -Radius; x <= Radius; ++x)
+	{
+		int64_t y = (int64_t)sqrt((double)(Radius * Radius - x * x));
+		if((x * x + y * y) == (Radius * Radius))
+		{
+			Points[2][2 * PointCounts[2] + 0] = (int32_t)x;
+			Points[2][2 * PointCounts[2] + 1] = (int32_t)y;
+			PointCounts[2]++;
+			if(y != 0)
+			{
+				Points[2][2 * PointCounts[2] + 0] = (int32_t)x;
+				Points[2][2 * PointCounts[2] + 1] = (int32_t)-y;
+				PointCounts[2]++;
+			}
+		}
+	}
+
+	for(int PointIndex = 0; PointIndex < 400; ++PointIndex)
+	{
+		int32_t x = (int32_t)(XorShift32(&RandomState) & 0x3FFFFF);
+		Points[3][2 * PointIndex + 0] = x;
+		Points[3][2 * PointIndex + 1] = (int32_t)floor(x * 0.6180339887);
+	}
+	PointCounts[3] = 400;
+
+	bool Valid = CheckExactPredicates(Points[2], PointCounts[2]);
+	for(int SetIndex = 0; SetIndex < 4; ++SetIndex)
+	{
+		int32_t* SetPoints = Points[SetIndex];
+		int PointCount = PointCounts[SetIndex];
+		Valid = CheckKernelTriangulation<kernel_i32>("i32", SetNames[SetIndex], PointCount, SetPoints, 0, 1, "as is") && Valid;
+		Valid = CheckKernelTriangulation<kernel_i32>("i32", SetNames[SetIndex], PointCount, SetPoints, 1 << 27, 1, "2^27 + p") && Valid;
+		Valid = CheckKernelTriangulation<kernel_i64>("i64", SetNames[SetIndex], PointCount, SetPoints, 0, int64_t(1) << 24, "2^24 p") && Valid;
+		Valid = CheckKernelTriangulation<kernel_i64>("i64", SetNames[SetIndex], PointCount, SetPoints, int64_t(1) << 50, 1, "2^50 + p") && Valid;
+		Valid = CheckKernelTriangulation<kernel_f64>("f64", SetNames[SetIndex], PointCount, SetPoints, 0.0, ldexp(1.0, 40), "2^40 p") && Valid;
+		Valid = CheckKernelTriangulation<kernel_f64>("f64", SetNames[SetIndex], PointCount, SetPoints, 1024.0, ldexp(1.0, -20), "1024 + 2^-20 p") && Valid;
+	}
+
+	return(Valid ? 0 : 1);
+}
+
+int RunBatchBenchmark(int SetCount, int PointCountPerSet)
+{
+	// NOTE(hugo) : Random sets on a 2^16 grid, triangulated on every core. Build with -O2 (and without DELONE_SLOW) before trusting the numbers.
+	// The triangle indices of the whole batch have to fit in an int.
+	if((SetCount < 1) || (PointCountPerSet < 1) || ((int64_t)SetCount * PointCountPerSet > (1 << 28)))
+	{
+		printf("Expected at least one set of at least 1 point, and at most %i points in all.\n", 1 << 28);
+		return(1);
+	}
+
+	int PointCount = SetCount * PointCountPerSet;
+	int ThreadCount = GetWorkerThreadCount();
+	triangulation_batch<kernel_i32> Batch = {};
+	Batch.Positions = (int32_t*)malloc(2 * (size_t)PointCount * sizeof(int32_t));
+	Batch.Sets = (batch_set*)malloc(SetCount * sizeof(batch_set));
+	Batch.TriangleVertexIndices = (int*)malloc(3 * 2 * (size_t)PointCount * sizeof(int));
+	batch_worker<kernel_i32>* Workers = (batch_worker<kernel_i32>*)calloc(ThreadCount, sizeof(batch_worker<kernel_i32>));
+	if(!Batch.Positions || !Batch.Sets || !Batch.TriangleVertexIndices || !Workers)
+	{
+		printf("Could not allocate the batch.\n");
+		free(Workers);
+		free(Batch.TriangleVertexIndices);
+		free(Batch.Sets);
+		free(Batch.Positions);
+		return(1);
+	}
+	Batch.SetCount = SetCount;
+
+	uint32_t RandomState = 0x9E3779B9;
+	for(int PointIndex = 0; PointIndex < 2 * PointCount; ++PointIndex)
+	{
+		Batch.Positions[PointIndex] = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+	}
+	for(int SetIndex = 0; SetIndex < SetCount; ++SetIndex)
+	{
+		Batch.Sets[SetIndex].FirstPointIndex = SetIndex * PointCountPerSet;
+		Batch.Sets[SetIndex].PointCount = PointCountPerSet;
+	}
+	Assert(GetBatchTriangleCapacity(Batch.Sets, SetCount) == 2 * PointCount);
+
+	uint64_t CounterFrequency = SDL_GetPerformanceFrequency();
+	uint64_t Start = SDL_GetPerformanceCounter();
+	int TriangleCount = TriangulateBatch(&Batch, Workers, ThreadCount);
+	uint64_t End = SDL_GetPerformanceCounter();
+
+	uint64_t BusyCounter = 0;
+	for(int ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		BusyCounter += Workers[ThreadIndex].BusyCounter;
+	}
+	double Seconds = (double)(End - Start) / (double)CounterFrequency;
+	double BusySeconds = (double)BusyCounter / (double)CounterFrequency;
+	uint64_t Hash = HashBytes(14695981039346656037ULL, Batch.TriangleVertexIndices, 3 * (size_t)TriangleCount * sizeof(int));
+
+	printf("Batch of %i sets of %i points on %i threads\n", SetCount, PointCountPerSet, ThreadCount);
+	printf("time         : %.3f s, %.0f triangulations/s, %.0f triangulations/s per core\n",
+			Seconds, SetCount / Seconds, (BusySeconds > 0.0) ? (SetCount / BusySeconds) : 0.0);
+	printf("output       : %i triangles, hash %016llx\n", TriangleCount, (unsigned long long)Hash);
+
+	FreeBatchWorkers(Workers, ThreadCount);
+	free(Workers);
+	free(Batch.TriangleVertexIndices);
+	free(Batch.Sets);
+	free(Batch.Positions);
+	return(0);
+}
+
+bool IsBatchSetDelaunay(triangulation_batch<kernel_i32>* Batch, batch_set* Set)
+{
+	int VertexCount = Set->PointCount - Set->DuplicatePointCount;
+	return(IsTriangleListDelaunay(Batch->Positions + 2 * Set->FirstPointIndex, Set->PointCount, VertexCount,
+				Batch->TriangleVertexIndices + 3 * Set->FirstTriangleIndex, Set->TriangleCount));
+}
+
+int RunBatchRangeCheck()
+{
+	// NOTE(hugo) : Sets at the limits of the int32 kernel range in a single batch, and one larger than
+	// MAX_POINT_COUNT. The ones in range must give a Delaunay triangulation, the others must be rejected
+	// without stopping the rest of the batch.
+	int32_t Max = (int32_t)kernel_i32::MaxCoordinate;
+	struct range_test_set
+	{
+		const char* Name;
+		int32_t MinX;
+		int32_t MinY;
+		int32_t Width;
+		int32_t Height;
+		int PointCount;
+		batch_set_status ExpectedStatus;
+	};
+	range_test_set Tests[] =
+	{
+		{"small, centered", -500, -500, 1000, 1000, 200, BatchSet_Triangulated},
+		{"3000 points", 0, 0, 100000, 100000, 3000, BatchSet_Triangulated},
+		{"extent 5e7, centered", -25000000, -25000000, 50000000, 50000000, 200, BatchSet_Triangulated},
+		{"extent 2^28, centered", -(1 << 27), -(1 << 27), 1 << 28, 1 << 28, 200, BatchSet_Triangulated},
+		{"extent 1e8, top right", Max - 100000000, Max - 100000000, 99999999, 99999999, 200, BatchSet_Triangulated},
+		{"extent 1e8, bottom left", -Max + 1, -Max + 1, 99999999, 99999999, 200, BatchSet_Triangulated},
+		{"extent 1e8, right side", Max - 100000000, -50000000, 99999999, 100000000, 200, BatchSet_Triangulated},
+		{"whole range", -Max, -Max, 2 * Max, 2 * Max, 200, BatchSet_Triangulated},
+		{"whole range, thin strip", -Max, -1, 2 * Max, 2, 200, BatchSet_Triangulated},
+		{"touching the limit", Max - 1000, 0, 1000, 1000, 200, BatchSet_Triangulated},
+		{"past the limit", Max - 1000, 0, 1001, 1000, 200, BatchSet_OutOfRange},
+		{"small, after the rejected ones", 1000, 1000, 1000, 1000, 200, BatchSet_Triangulated},
+	};
+	int SetCount = sizeof(Tests) / sizeof(Tests[0]);
+
+	int PointCount = 0;
+	for(int SetIndex = 0; SetIndex < SetCount; ++SetIndex)
+	{
+		PointCount += Tests[SetIndex].PointCount;
+	}
+	int ThreadCount = GetWorkerThreadCount();
+	triangulation_batch<kernel_i32> Batch = {};
+	Batch.Positions = (int32_t*)malloc(2 * (size_t)PointCount * sizeof(int32_t));
+	Batch.Sets = (batch_set*)malloc(SetCount * sizeof(batch_set));
+	Batch.TriangleVertexIndices = (int*)malloc(3 * 2 * (size_t)PointCount * sizeof(int));
+	batch_worker<kernel_i32>* Workers = (batch_worker<kernel_i32>*)calloc(ThreadCount, sizeof(batch_worker<kernel_i32>));
+	if(!Batch.Positions || !Batch.Sets || !Batch.TriangleVertexIndices || !Workers)
+	{
+		printf("Could not allocate the batch.\n");
+		free(Workers);
+		free(Batch.TriangleVertexIndices);
+		free(Batch.Sets);
+		free(Batch.Positions);
+		return(1);
+	}
+	Batch.SetCount = SetCount;
+
+	// NOTE(hugo) : Every set has a point on each corner of its box, the others are random inside
+	uint32_t RandomState = 0x9E3779B9;
+	int FirstPointIndex = 0;
+	for(int SetIndex = 0; SetIndex < SetCount; ++SetIndex)
+	{
+		range_test_set* Test = Tests + SetIndex;
+		for(int PointIndex = 0; PointIndex < Test->PointCount; ++PointIndex)
+		{
+			int64_t Coordinates[2];
+			for(int i = 0; i < 2; ++i)
+			{
+				int64_t Size = (i == 0) ? Test->Width : Test->Height;
+				int64_t Offset = (PointIndex < 4) ? (((PointIndex >> i) & 1) ? Size : 0) : (XorShift32(&RandomState) % (Size + 1));
+				Coordinates[i] = ((i == 0) ? Test->MinX : Test->MinY) + Offset;
+			}
+			Batch.Positions[2 * (FirstPointIndex + PointIndex) + 0] = (int32_t)Coordinates[0];
+			Batch.Positions[2 * (FirstPointIndex + PointIndex) + 1] = (int32_t)Coordinates[1];
+		}
+		Batch.Sets[SetIndex].FirstPointIndex = FirstPointIndex;
+		Batch.Sets[SetIndex].PointCount = Test->PointCount;
+		FirstPointIndex += Test->PointCount;
+	}
+	Assert(GetBatchTriangleCapacity(Batch.Sets, SetCount) == 2 * PointCount);
+	TriangulateBatch(&Batch, Workers, ThreadCount);
+
+	const char* StatusNames[] = {"triangulated", "too many points", "out of range"};
+	bool Valid = true;
+	for(int SetIndex = 0; SetIndex < SetCount; ++SetIndex)
+	{
+		batch_set* Set = Batch.Sets + SetIndex;
+		bool SetValid = (Set->Status == Tests[SetIndex].ExpectedStatus)
+			&& ((Set->Status != BatchSet_Triangulated) ? (Set->TriangleCount == 0) : IsBatchSetDelaunay(&Batch, Set));
+		printf("%-32s : %s, %i triangles, %s\n", Tests[SetIndex].Name, StatusNames[Set->Status], Set->TriangleCount, SetValid ? "ok" : "FAILED");
+		Valid = Valid && SetValid;
+	}
+
+	FreeBatchWorkers(Workers, ThreadCount);
+	free(Workers);
+	free(Batch.TriangleVertexIndices);
+	free(Batch.Sets);
+	free(Batch.Positions);
+	return(Valid ? 0 : 1);
+}
+
+bool CheckProximityGraphs(compact_mesh<kernel_i32>* Mesh, const char* Name)
+{
+	// NOTE(hugo) : Every graph is checked against a brute force search over all the points. GG and RNG are
+	// subgraphs of the Delaunay triangulation, so brute forcing the mesh edges is enough, and the extractors
+	// give their edges in the order of BuildMeshEdges.
+	static mesh_edges Edges;
+	static edge_list Tree;
+	static edge_list Gabriel;
+	static edge_list Relative;
+	static int NearestNeighbours[MAX_NEAREST_NEIGHBOUR_COUNT * MAX_POINT_COUNT];
+	int NeighbourCount = 8;
+	BuildMeshEdges(Mesh, &Edges);
+
+	uint64_t CounterFrequency = SDL_GetPerformanceFrequency();
+	uint64_t Counters[5];
+	Counters[0] = SDL_GetPerformanceCounter();
+	ExtractEuclideanMinimumSpanningTree(Mesh, &Tree);
+	Counters[1] = SDL_GetPerformanceCounter();
+	ExtractGabrielGraph(Mesh, &Gabriel);
+	Counters[2] = SDL_GetPerformanceCounter();
+	ExtractRelativeNeighbourhoodGraph(Mesh, &Relative);
+	Counters[3] = SDL_GetPerformanceCounter();
+	ExtractApproximateNearestNeighbours(Mesh, NeighbourCount, NearestNeighbours);
+	Counters[4] = SDL_GetPerformanceCounter();
+
+	bool Valid = (Mesh->TriangleCount > 0);
+
+	// NOTE(hugo) : EMST, the lengths of any two minimum spanning trees are the same multiset : Prim against Kruskal
+	sort_entry TreeKeys[MAX_POINT_COUNT];
+	sort_entry PrimKeys[MAX_POINT_COUNT];
+	sort_entry SortTemp[MAX_POINT_COUNT];
+	uint64_t BestKeys[MAX_POINT_COUNT];
+	bool IsInTree[MAX_POINT_COUNT];
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		BestKeys[VertexIndex] = kernel_i32::SquaredDistanceKey(GetMeshVertex(Mesh, 0), GetMeshVertex(Mesh, VertexIndex));
+		IsInTree[VertexIndex] = (VertexIndex == 0);
+	}
+	for(int PrimIndex = 0; PrimIndex < Mesh->VertexCount - 1; ++PrimIndex)
+	{
+		int ClosestIndex = -1;
+		for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+		{
+			if(!IsInTree[VertexIndex] && ((ClosestIndex == -1) || (BestKeys[VertexIndex] < BestKeys[ClosestIndex])))
+			{
+				ClosestIndex = VertexIndex;
+			}
+		}
+		IsInTree[ClosestIndex] = true;
+		PrimKeys[PrimIndex].SortKey = BestKeys[ClosestIndex];
+		PrimKeys[PrimIndex].Index = PrimIndex;
+		for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+		{
+			uint64_t Key = kernel_i32::SquaredDistanceKey(GetMeshVertex(Mesh, ClosestIndex), GetMeshVertex(Mesh, VertexIndex));
+			BestKeys[VertexIndex] = (Key < BestKeys[VertexIndex]) ? Key : BestKeys[VertexIndex];
+		}
+	}
+	Valid = Valid && (Tree.EdgeCount == Mesh->VertexCount - 1);
+	for(int EdgeIndex = 0; Valid && (EdgeIndex < Tree.EdgeCount); ++EdgeIndex)
+	{
+		TreeKeys[EdgeIndex].SortKey = kernel_i32::SquaredDistanceKey(GetMeshVertex(Mesh, Tree.VertexIndices[2 * EdgeIndex + 0]),
+				GetMeshVertex(Mesh, Tree.VertexIndices[2 * EdgeIndex + 1]));
+		TreeKeys[EdgeIndex].Index = EdgeIndex;
+	}
+	if(Valid)
+	{
+		MergeSort(Tree.EdgeCount, TreeKeys, SortTemp);
+		MergeSort(Tree.EdgeCount, PrimKeys, SortTemp);
+		for(int EdgeIndex = 0; EdgeIndex < Tree.EdgeCount; ++EdgeIndex)
+		{
+			Valid = Valid && (TreeKeys[EdgeIndex].SortKey == PrimKeys[EdgeIndex].SortKey);
+		}
+	}
+
+	// NOTE(hugo) : Gabriel graph and RNG
+	int GabrielIndex = 0;
+	int RelativeIndex = 0;
+	for(int EdgeIndex = 0; Valid && (EdgeIndex < Edges.EdgeCount); ++EdgeIndex)
+	{
+		int PIndex = Edges.VertexIndices[2 * EdgeIndex + 0];
+		int QIndex = Edges.VertexIndices[2 * EdgeIndex + 1];
+		vertex<kernel_i32> P = GetMeshVertex(Mesh, PIndex);
+		vertex<kernel_i32> Q = GetMeshVertex(Mesh, QIndex);
+		bool IsGabriel = true;
+		bool IsRelative = true;
+		for(int RIndex = 0; RIndex < Mesh->VertexCount; ++RIndex)
+		{
+			if((RIndex != PIndex) && (RIndex != QIndex))
+			{
+				IsGabriel = IsGabriel && (kernel_i32::Dot2D(P, Q, GetMeshVertex(Mesh, RIndex)) > 0);
+				IsRelative = IsRelative && !IsInLune(Mesh, PIndex, QIndex, RIndex);
+			}
+		}
+		if(IsGabriel)
+		{
+			Valid = (GabrielIndex < Gabriel.EdgeCount) && (Gabriel.VertexIndices[2 * GabrielIndex + 0] == PIndex)
+				&& (Gabriel.VertexIndices[2 * GabrielIndex + 1] == QIndex);
+			GabrielIndex++;
+		}
+		if(Valid && IsRelative)
+		{
+			Valid = (RelativeIndex < Relative.EdgeCount) && (Relative.VertexIndices[2 * RelativeIndex + 0] == PIndex)
+				&& (Relative.VertexIndices[2 * RelativeIndex + 1] == QIndex);
+			RelativeIndex++;
+		}
+	}
+	Valid = Valid && (GabrielIndex == Gabriel.EdgeCount) && (RelativeIndex == Relative.EdgeCount);
+
+	// NOTE(hugo) : Nearest neighbours, the first one is exact and they come closest first
+	for(int VertexIndex = 0; Valid && (VertexIndex < Mesh->VertexCount); ++VertexIndex)
+	{
+		vertex<kernel_i32> V = GetMeshVertex(Mesh, VertexIndex);
+		int* Neighbours = NearestNeighbours + NeighbourCount * VertexIndex;
+		uint64_t NearestKey = UINT64_MAX;
+		for(int OtherIndex = 0; OtherIndex < Mesh->VertexCount; ++OtherIndex)
+		{
+			uint64_t Key = kernel_i32::SquaredDistanceKey(V, GetMeshVertex(Mesh, OtherIndex));
+			NearestKey = ((OtherIndex != VertexIndex) && (Key < NearestKey)) ? Key : NearestKey;
+		}
+		Valid = (Neighbours[0] != -1) && (kernel_i32::SquaredDistanceKey(V, GetMeshVertex(Mesh, Neighbours[0])) == NearestKey);
+		for(int i = 1; Valid && (i < NeighbourCount) && (Neighbours[i] != -1); ++i)
+		{
+			Valid = (kernel_i32::SquaredDistanceKey(V, GetMeshVertex(Mesh, Neighbours[i - 1])) <= kernel_i32::SquaredDistanceKey(V, GetMeshVertex(Mesh, Neighbours[i])));
+		}
+	}
+
+	double Microseconds[4];
+	for(int i = 0; i < 4; ++i)
+	{
+		Microseconds[i] = (double)((Counters[i + 1] - Counters[i]) * 1000000) / (double)CounterFrequency;
+	}
+	printf("%-12s : %4i points, emst %5i edges %7.0f us, gabriel %5i edges %7.0f us, rng %5i edges %7.0f us, knn %7.0f us, %s\n",
+			Name, Mesh->VertexCount, Tree.EdgeCount, Microseconds[0], Gabriel.EdgeCount, Microseconds[1],
+			Relative.EdgeCount, Microseconds[2], Microseconds[3], Valid ? "ok" : "MISMATCH");
+
+	return(Valid);
+}
+
+int RunProximityCheck(int PointCount)
+{
+	// NOTE(hugo) : Random points on a 2^16 grid, then two parallel rows far apart, which was the worst case of the RNG walk
+	if((PointCount < 4) || (PointCount > MAX_POINT_COUNT - 3))
+	{
+		printf("Expected 4 to %i points.\n", MAX_POINT_COUNT - 3);
+		return(1);
+	}
+
+	static triangulation_storage<kernel_i32> TStorage;
+	static triangulation_storage<kernel_i32> HullScratchStorage;
+	triangulation<kernel_i32> T;
+	triangulation<kernel_i32> HullScratch;
+	AttachTriangulationStorage(&T, &TStorage);
+	AttachTriangulationStorage(&HullScratch, &HullScratchStorage);
+	static compact_mesh<kernel_i32> Mesh;
+
+	InitTriangulationWithSuperTriangle(&T, 0, 0xFFFF);
+	uint32_t RandomState = 0x9E3779B9;
+	for(int PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+	{
+		int32_t x = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+		int32_t y = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+		vertex<kernel_i32> V = {x, y, true};
+		InsertVertex(&T, V);
+	}
+	FinalizeTriangulation(&T, &Mesh, &HullScratch);
+	bool Valid = CheckProximityGraphs(&Mesh, "random");
+
+	int RowSpacing = 64;
+	int RowDistance = RowSpacing * (PointCount / 4);
+	int RowLength = RowSpacing * ((PointCount - 1) / 2);
+	InitTriangulationWithSuperTriangle(&T, 0, (RowDistance > RowLength) ? RowDistance : RowLength);
+	for(int PointIndex = 0; PointIndex < PointCount; ++PointIndex)
+	{
+		vertex<kernel_i32> V = {RowSpacing * (PointIndex / 2), RowDistance * (PointIndex % 2), true};
+		InsertVertex(&T, V);
+	}
+	FinalizeTriangulation(&T, &Mesh, &HullScratch);
+	Valid = CheckProximityGraphs(&Mesh, "two rows") && Valid;
+
+	return(Valid ? 0 : 1);
+}
+
+bool CheckRasterReproducesLinearField(compact_mesh<kernel_i32>* Mesh, raster_grid* Grid, interpolation_mode Mode,
+		double* Coefficients, int ThreadCount)
+{
+	// NOTE(hugo) : Both interpolations reproduce a linear field exactly. Pixels inside the hull must hold the field,
+	// and NoDataValue is only allowed for pixel centers that are not strictly inside the hull.
+	static float VertexValues[MAX_POINT_COUNT];
+	for(int VertexIndex = 0; VertexIndex < Mesh->VertexCount; ++VertexIndex)
+	{
+		VertexValues[Mesh->SourceVertexIndices[VertexIndex]] = (float)(Coefficients[0]
+				+ Coefficients[1] * Mesh->Positions[2 * VertexIndex + 0] + Coefficients[2] * Mesh->Positions[2 * VertexIndex + 1]);
+	}
+
+	uint64_t CounterFrequency = SDL_GetPerformanceFrequency();
+	uint64_t Start = SDL_GetPerformanceCounter();
+	if(!RasterizeInterpolation(Mesh, VertexValues, Grid, Mode, ThreadCount))
+	{
+		printf("Could not allocate the raster job.\n");
+		return(false);
+	}
+	uint64_t End = SDL_GetPerformanceCounter();
+
+	int DataPixelCount = 0;
+	int WrongPixelCount = 0;
+	double MaxError = 0.0;
+	for(int y = 0; y < Grid->Height; ++y)
+	{
+		for(int x = 0; x < Grid->Width; ++x)
+		{
+			double WorldX = Grid->OriginX + (x + 0.5) * Grid->CellSize;
+			double WorldY = Grid->OriginY + (y + 0.5) * Grid->CellSize;
+			float Value = Grid->Values[(size_t)y * Grid->Width + x];
+			if(Value == Grid->NoDataValue)
+			{
+				bool IsStrictlyInside = true;
+				for(int HullIndex = 0; HullIndex < Mesh->HullVertexCount; ++HullIndex)
+				{
+					int AIndex = Mesh->HullVertexIndices[HullIndex];
+					int BIndex = Mesh->HullVertexIndices[(HullIndex + 1) % Mesh->HullVertexCount];
+					double ax = Mesh->Positions[2 * AIndex + 0];
+					double ay = Mesh->Positions[2 * AIndex + 1];
+					double bx = Mesh->Positions[2 * BIndex + 0];
+					double by = Mesh->Positions[2 * BIndex + 1];
+					IsStrictlyInside = IsStrictlyInside && (((bx - ax) * (WorldY - ay) - (by - ay) * (WorldX - ax)) > 0.0);
+				}
+				WrongPixelCount += IsStrictlyInside;
+			}
+			else
+			{
+				double Expected = Coefficients[0] + Coefficients[1] * WorldX + Coefficients[2] * WorldY;
+				double Error = fabs(Value - Expected);
+				MaxError = (Error > MaxError) ? Error : MaxError;
+				DataPixelCount++;
+			}
+		}
+	}
+
+	// NOTE(hugo) : The values are floats, a few ulps of the largest value are tolerated
+	double Tolerance = 1e-5 * (fabs(Coefficients[0]) + (fabs(Coefficients[1]) + fabs(Coefficients[2])) * 65536.0);
+	bool Valid = (WrongPixelCount == 0) && (MaxError <= Tolerance) && (DataPixelCount > 0);
+	printf("%-12s : %ix%i on %i threads %8.1f ms, %i pixels with data, max error %g, %s\n",
+			(Mode == Interpolation_Linear) ? "linear" : "natural", Grid->Width, Grid->Height, ThreadCount,
+			(double)((End - Start) * 1000) / (double)CounterFrequency, DataPixelCount, MaxError, Valid ? "ok" : "MISMATCH");
+
+	return(Valid);
+}
+
+int RunRasterCheck(int Size)
+{
+	// NOTE(hugo) : Random points on a 2^16 grid carrying a linear field, rasterized on a Size x Size grid
+	// that sticks out of their hull on every side
+	if((Size < 1) || (Size > 16384))
+	{
+		printf("Expected a raster size from 1 to 16384.\n");
+		return(1);
+	}
+
+	static triangulation_storage<kernel_i32> TStorage;
+	static triangulation_storage<kernel_i32> HullScratchStorage;
+	triangulation<kernel_i32> T;
+	triangulation<kernel_i32> HullScratch;
+	AttachTriangulationStorage(&T, &TStorage);
+	AttachTriangulationStorage(&HullScratch, &HullScratchStorage);
+	static compact_mesh<kernel_i32> Mesh;
+	InitTriangulationWithSuperTriangle(&T, 0, 0xFFFF);
+	uint32_t RandomState = 0x9E3779B9;
+	for(int PointIndex = 0; PointIndex < MAX_POINT_COUNT - 3; ++PointIndex)
+	{
+		int32_t x = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+		int32_t y = (int32_t)(XorShift32(&RandomState) & 0xFFFF);
+		vertex<kernel_i32> V = {x, y, true};
+		InsertVertex(&T, V);
+	}
+	FinalizeTriangulation(&T, &Mesh, &HullScratch);
+
+	raster_grid Grid = {};
+	Grid.Width = Size;
+	Grid.Height = Size;
+	Grid.OriginX = -1024.0;
+	Grid.OriginY = -1024.0;
+	Grid.CellSize = (65536.0 + 2048.0) / Size;
+	Grid.NoDataValue = -1e30f;
+	Grid.Values = (float*)malloc((size_t)Size * Size * sizeof(float));
+	if(!Grid.Values)
+	{
+		printf("Could not allocate a %ix%i raster.\n", Size, Size);
+		return(1);
+	}
+
+	double Coefficients[3] = {100.0, 0.25, -0.125};
+	int ThreadCount = GetWorkerThreadCount();
+	bool Valid = CheckRasterReproducesLinearField(&Mesh, &Grid, Interpolation_Linear, Coefficients, 1);
+	Valid = CheckRasterReproducesLinearField(&Mesh, &Grid, Interpolation_Linear, Coefficients, ThreadCount) && Valid;
+	Valid = CheckRasterReproducesLinearField(&Mesh, &Grid, Interpolation_NaturalNeighbour, Coefficients, ThreadCount) && Valid;
+
+	free(Grid.Values);
+	return(Valid ? 0 : 1);
+}
+
+uint64_t HashTetrahedra(tetrahedralization* T)
+{
+	// NOTE(hugo) : Does not depend on the numbering of the tetrahedra nor on the order of their vertices
+	uint64_t Result = 0;
+	for(int TetrahedronIndex = 0; TetrahedronIndex < T->TetrahedronCount; ++TetrahedronIndex)
+	{
+		if(IsTetrahedronAlive(T, TetrahedronIndex))
+		{
+			int* VertexIndices = T->Tetrahedra[TetrahedronIndex].VertexIndices;
+			uint64_t Hash = 1;
+			for(int i = 0; i < 4; ++i)
+			{
+				Hash *= 0x9E3779B97F4A7C15ull + 2 * (uint64_t)VertexIndices[i];
+			}
+			Result += Hash ^ (Hash >> 29);
+		}
+	}
+
+	return(Result);
+}
+
+int RunTetrahedralizationCheck(int PointCount)
+{
+	// NOTE(hugo) : Random points in the unit cube, on one thread then on all of them (at least 4, so that the
+	// locking runs even on a single core) which must give the same tetrahedra. Then a 8x8x8 grid (all
+	// cospherical by 8) and a plane that must be rejected.
+	if(PointCount < 4)
+	{
+		printf("Expected at least 4 points.\n");
+		return(1);
+	}
+
+	int ThreadCount = GetWorkerThreadCount();
+	ThreadCount = (ThreadCount < 4) ? 4 : ThreadCount;
+	int MaxPointCount = (PointCount > 512) ? PointCount : 512;
+	size_t MemorySize = GetTetrahedralizationMemorySize(MaxPointCount, ThreadCount);
+	void* Memory = malloc(MemorySize);
+	double* Positions = (double*)malloc(3 * (size_t)MaxPointCount * sizeof(double));
+	if(!Memory || !Positions)
+	{
+		printf("Could not allocate %i points.\n", PointCount);
+		free(Memory);
+		free(Positions);
+		return(1);
+	}
+	static tetrahedralization T;
+	uint64_t CounterFrequency = SDL_GetPerformanceFrequency();
+
+	uint32_t RandomState = 0x9E3779B9;
+	for(int i = 0; i < 3 * PointCount; ++i)
+	{
+		Positions[i] = (double)XorShift32(&RandomState) / 4294967296.0;
+	}
+	bool Valid = true;
+	uint64_t SingleThreadHash = 0;
+	int RunThreadCounts[2] = {1, ThreadCount};
+	for(int RunIndex = 0; RunIndex < ArrayCount(RunThreadCounts); ++RunIndex)
+	{
+		InitTetrahedralization(&T, Memory, MemorySize, MaxPointCount, ThreadCount);
+		uint64_t Start = SDL_GetPerformanceCounter();
+		bool RunValid = Tetrahedralize(&T, PointCount, Positions, RunThreadCounts[RunIndex]);
+		uint64_t End = SDL_GetPerformanceCounter();
+		int FiniteCount = 0;
+		int InfiniteCount = 0;
+		for(int TetrahedronIndex = 0; TetrahedronIndex < T.TetrahedronCount; ++TetrahedronIndex)
+		{
+			if(IsTetrahedronAlive(&T, TetrahedronIndex))
+			{
+				FiniteCount += IsFiniteTetrahedron(&T, TetrahedronIndex);
+				InfiniteCount += !IsFiniteTetrahedron(&T, TetrahedronIndex);
+			}
+		}
+		RunValid = RunValid && IsTetrahedralizationValid(&T);
+		uint64_t ValidEnd = SDL_GetPerformanceCounter();
+		uint64_t Hash = HashTetrahedra(&T);
+		SingleThreadHash = (RunIndex == 0) ? Hash : SingleThreadHash;
+		RunValid = RunValid && (Hash == SingleThreadHash);
+		printf("random       : %i points, %i threads, %.3f s, %i tetrahedra + %i on the hull, %i duplicates, checked in %.3f s, %s\n",
+				PointCount, RunThreadCounts[RunIndex], (double)(End - Start) / (double)CounterFrequency, FiniteCount, InfiniteCount,
+				T.DuplicateVertexCount, (double)(ValidEnd - End) / (double)CounterFrequency, RunValid ? "ok" : "INVALID");
+		Valid = Valid && RunValid;
+	}
+
+	int GridPointCount = 0;
+	for(int z = 0; z < 8; ++z)
+	{
+		for(int y = 0; y < 8; ++y)
+		{
+			for(int x = 0; x < 8; ++x)
+			{
+				Positions[3 * GridPointCount + 0] = x;
+				Positions[3 * GridPointCount + 1] = y;
+				Positions[3 * GridPointCount + 2] = z;
+				GridPointCount++;
+			}
+		}
+	}
+	InitTetrahedralization(&T, Memory, MemorySize, MaxPointCount, ThreadCount);
+	bool GridValid = Tetrahedralize(&T, GridPointCount, Positions, ThreadCount) && IsTetrahedralizationValid(&T);
+	printf("grid         : %i points, %s\n", GridPointCount, GridValid ? "ok" : "INVALID");
+
+	for(int PointIndex = 0; PointIndex < GridPointCount; ++PointIndex)
+	{
+		Positions[3 * PointIndex + 2] = 0.0;
+	}
+	InitTetrahedralization(&T, Memory, MemorySize, MaxPointCount, ThreadCount);
+	bool PlaneRejected = !Tetrahedralize(&T, GridPointCount, Positions, ThreadCount);
+	printf("plane        : %i points, %s\n", GridPointCount, PlaneRejected ? "rejected, ok" : "NOT REJECTED");
+
+	free(Positions);
+	free(Memory);
+	return((Valid && GridValid && PlaneRejected) ? 0 : 1);
+}
+
+int main(int ArgumentCount, char** Arguments)
+{
+	// NOTE(hugo) : delone [-record <file>] | -replay <file> [-hash <expected mesh hash>] | -batch <set count> <points per set>
+	//                | -batchrange | -proximity <point count> | -raster <grid size> | -tetra <point count> | -kernels
+	char* RecordPath = 0;
+	char* ReplayPath = 0;
+	char* ExpectedHash = 0;
+	char* BatchSetCount = 0;
+	char* BatchPointCount = 0;
+	bool BatchRangeCheck = false;
+	char* ProximityPointCount = 0;
+	char* RasterSize = 0;
+	char* TetraPointCount = 0;
+	bool KernelCheck = false;
+	for(int ArgumentIndex = 1; ArgumentIndex < ArgumentCount; ++ArgumentIndex)
+	{
+		bool HasValue = (ArgumentIndex + 1 < ArgumentCount);
+		if(HasValue && (strcmp(Arguments[ArgumentIndex], "-record") == 0))
+		{
+			RecordPath = Arguments[++ArgumentIndex];
+		}
+		else if(HasValue && (strcmp(Arguments[ArgumentIndex], "-replay") == 0))
+		{
+			ReplayPath = Arguments[++ArgumentIndex];
+		}
+		else if(HasValue && (strcmp(Arguments[ArgumentIndex], "-hash") == 0))
+		{
+			ExpectedHash = Arguments[++ArgumentIndex];
+		}
+		else if((ArgumentIndex + 2 < ArgumentCount) && (strcmp(Arguments[ArgumentIndex], "-batch") == 0))
+		{
+			BatchSetCount = Arguments[++ArgumentIndex];
+			BatchPointCount = Arguments[++ArgumentIndex];
+		}
+		else if(strcmp(Arguments[ArgumentIndex], "-batchrange") == 0)
+		{
+			BatchRangeCheck = true;
+		}
+		else if(HasValue && (strcmp(Arguments[ArgumentIndex], "-proximity") == 0))
+		{
+			ProximityPointCount = Arguments[++ArgumentIndex];
+		}
+		else if(HasValue && (strcmp(Arguments[ArgumentIndex], "-raster") == 0))
+		{
+			RasterSize = Arguments[++ArgumentIndex];
+		}
+		else if(HasValue && (strcmp(Arguments[ArgumentIndex], "-tetra") == 0))
+		{
+			TetraPointCount = Arguments[++ArgumentIndex];
+		}
+		else if(strcmp(Arguments[ArgumentIndex], "-kernels") == 0)
+		{
+			KernelCheck = true;
+		}
+		else
+		{
+			printf("Unknown argument %s\n", Arguments[ArgumentIndex]);
+			return(1);
+		}
+	}
+
+	if(ReplayPath)
+	{
+		return(ReplayRecording(ReplayPath, ExpectedHash));
+	}
+	if(BatchSetCount)
+	{
+		return(RunBatchBenchmark(atoi(BatchSetCount), atoi(BatchPointCount)));
+	}
+	if(BatchRangeCheck)
+	{
+		return(RunBatchRangeCheck());
+	}
+	if(ProximityPointCount)
+	{
+		return(RunProximityCheck(atoi(ProximityPointCount)));
+	}
+	if(RasterSize)
+	{
+		return(RunRasterCheck(atoi(RasterSize)));
+	}
+	if(TetraPointCount)
+	{
+		return(RunTetrahedralizationCheck(atoi(TetraPointCount)));
+	}
+	if(KernelCheck)
+	{
+		return(RunKernelCheck());
+	}
+
+	SDL_Init(SDL_INIT_EVERYTHING);
+
+	SDL_Window* Window = SDL_CreateWindow("Delaunay Triangulation", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, ScreenWidth, ScreenHeight, 0);
+	Assert(Window);
 
 	SDL_Renderer* Renderer = SDL_CreateRenderer(Window, -1, SDL_RENDERER_ACCELERATED);
 	Assert(Renderer);
@@ -762,29 +3108,21 @@ int main(int ArgumentCount, char** Arguments)
 		printf("TTF Font : %s\n", TTF_GetError());
 	}
 
-	// NOTE(hugo) : Init graph
-	triangulation T = {};
-	T.VertexCount = 0;
-	T.EdgeCount = 0;
-	T.TriangleCount = 0;
-
-	int FarAwayCoordinate = 8000;
-	vertex FakePoint0 = {-100, ScreenHeight - (-FarAwayCoordinate), false};
-	vertex FakePoint1 = {-100, ScreenHeight - FarAwayCoordinate, false};
-	vertex FakePoint2 = {FarAwayCoordinate, ScreenHeight - FarAwayCoordinate, false};
-	edge E01 = {0, 1};
-	edge E12 = {1, 2};
-	edge E20 = {2, 0};
-	triangle F = {0, 1, 2, 0, 1, 2};
-	PushVertex(&T, FakePoint0);
-	PushVertex(&T, FakePoint1);
-	PushVertex(&T, FakePoint2);
-	PushEdge(&T, E01);
-	PushEdge(&T, E12);
-	PushEdge(&T, E20);
-	PushTriangle(&T, F);
+	FILE* RecordFile = 0;
+	if(RecordPath)
+	{
+		RecordFile = fopen(RecordPath, "w");
+		if(!RecordFile)
+		{
+			printf("Could not open %s for recording.\n", RecordPath);
+		}
+	}
 
-	bool DirtyTriangulation = false;
+	// NOTE(hugo) : Init graph
+	delone_state State = {};
+	AttachTriangulationStorage(&State.Triangulation, &State.TriangulationStorage);
+	InitScreenTriangulation(&State.Triangulation);
+	State.ConstraintFirstVertexIndex = -1;
 
 	while(Running)
 	{
@@ -800,26 +3138,31 @@ int main(int ArgumentCount, char** Arguments)
 					} break;
 				case SDL_MOUSEBUTTONDOWN:
 					{
-						if(Event.button.button == SDL_BUTTON_LEFT)
+						if((Event.button.button == SDL_BUTTON_LEFT) || (Event.button.button == SDL_BUTTON_RIGHT))
 						{
 							// NOTE(hugo) : Putting the point in normal coordinates (not the screen coordinates which is not correctly oriented)
-							vertex V = {Event.button.x, ScreenHeight - Event.button.y, true};
-							PushVertex(&T, V);
-							DirtyTriangulation = true;
+							recorded_input Input = {};
+							Input.Timestamp = Event.button.timestamp;
+							Input.Type = (Event.button.button == SDL_BUTTON_LEFT) ? Input_Point : Input_ConstraintClick;
+							Input.x = Event.button.x;
+							Input.y = ScreenHeight - Event.button.y;
+							if(RecordFile)
+							{
+								WriteInput(RecordFile, Input);
+							}
+							ProcessInput(&State, Input, Renderer, Font);
 						}
 					} break;
 			}
 		}
 
-		// NOTE(hugo) : Triangulation processing
-		if(DirtyTriangulation)
-		{
-			ComputeDelaunay(&T, Renderer, Font);
-			DirtyTriangulation = false;
-		}
+		Render(Renderer, &State.Triangulation, Font);
 
-		Render(Renderer, &T, Font);
+	}
 
+	if(RecordFile)
+	{
+		fclose(RecordFile);
 	}
 
 	SDL_DestroyRenderer(Renderer);